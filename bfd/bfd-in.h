@@ -351,8 +351,13 @@ struct bfd_hash_entry
 
 struct bfd_hash_table
 {
-  /* The hash array.  */
+  /* The hash array.  This is NULL for an open addressed table.  */
   struct bfd_hash_entry **table;
+  /* The slots of an open addressed table, created by
+     bfd_hash_table_init_open_n, or NULL.  The entries of such a
+     table are not chained, so they must be visited with
+     bfd_hash_traverse rather than by walking TABLE.  */
+  struct bfd_hash_slot *slots;
   /* A function used to create new elements in the hash table.  The
      first entry is itself a pointer to an element.  When this
      function is first invoked, this pointer will be NULL.  However,
@@ -391,6 +396,22 @@ extern bfd_boolean bfd_hash_table_init_n
 			       const char *),
    unsigned int, unsigned int);
 
+/* Initialize an open addressed hash table.  */
+extern bfd_boolean bfd_hash_table_init_open
+  (struct bfd_hash_table *,
+   struct bfd_hash_entry *(*) (struct bfd_hash_entry *,
+			       struct bfd_hash_table *,
+			       const char *),
+   unsigned int);
+
+/* Initialize an open addressed hash table specifying a size.  */
+extern bfd_boolean bfd_hash_table_init_open_n
+  (struct bfd_hash_table *,
+   struct bfd_hash_entry *(*) (struct bfd_hash_entry *,
+			       struct bfd_hash_table *,
+			       const char *),
+   unsigned int, unsigned int);
+
 /* Free up a hash table.  */
 extern void bfd_hash_table_free
   (struct bfd_hash_table *);
@@ -403,6 +424,16 @@ extern struct bfd_hash_entry *bfd_hash_lookup
   (struct bfd_hash_table *, const char *, bfd_boolean create,
    bfd_boolean copy);
 
+/* Return the hash code bfd_hash_lookup computes for a string.  */
+extern unsigned long bfd_hash_string_hash
+  (struct bfd_hash_table *, const char *);
+
+/* Start fetching the memory that a lookup of a string with the given
+   hash code will examine: the bucket at STAGE 0, the entry in it at
+   STAGE 1, and the entry's string at STAGE 2.  */
+extern void bfd_hash_prefetch
+  (struct bfd_hash_table *, unsigned long, int stage);
+
 /* Insert an entry in a hash table.  */
 extern struct bfd_hash_entry *bfd_hash_insert
   (struct bfd_hash_table *, const char *, unsigned long);
@@ -438,13 +469,14 @@ extern void bfd_hash_traverse
 extern unsigned long bfd_hash_set_default_size (unsigned long);
 
 /* Types of compressed DWARF debug sections.  We currently support
-   zlib.  */
+   zlib, and zstd if BFD was configured with it.  */
 enum compressed_debug_section_type
 {
   COMPRESS_DEBUG_NONE = 0,
   COMPRESS_DEBUG = 1 << 0,
   COMPRESS_DEBUG_GNU_ZLIB = COMPRESS_DEBUG | 1 << 1,
-  COMPRESS_DEBUG_GABI_ZLIB = COMPRESS_DEBUG | 1 << 2
+  COMPRESS_DEBUG_GABI_ZLIB = COMPRESS_DEBUG | 1 << 2,
+  COMPRESS_DEBUG_ZSTD = COMPRESS_DEBUG | 1 << 3
 };
 
 /* This structure is used to keep track of stabs in sections
@@ -533,6 +565,32 @@ extern bfd_boolean bfd_cache_close
 
 extern bfd_boolean bfd_cache_close_all (void);
 
+/* Statistics kept by the file descriptor cache.  */
+
+struct bfd_cache_stats
+{
+  /* Number of files opened, and number of those reopened after the
+     cache closed them to make room for another.  */
+  unsigned long opens;
+  unsigned long reopens;
+
+  /* Number of files closed to make room for another.  */
+  unsigned long evictions;
+
+  /* Number of read-only mappings made of evicted files, and number of
+     reads served from such a mapping instead of a reopened file.  */
+  unsigned long views;
+  unsigned long view_reads;
+
+  /* Bytes currently mapped, the largest number of bytes mapped at any
+     one time, and the limit on the number of bytes mapped.  */
+  bfd_size_type view_bytes;
+  bfd_size_type view_bytes_peak;
+  bfd_size_type view_budget;
+};
+
+extern void bfd_cache_get_stats (struct bfd_cache_stats *);
+
 extern bfd_boolean bfd_record_phdr
   (bfd *, unsigned long, bfd_boolean, flagword, bfd_boolean, bfd_vma,
    bfd_boolean, bfd_boolean, unsigned int, struct bfd_section **);
@@ -358,8 +358,13 @@ struct bfd_hash_entry
 
 struct bfd_hash_table
 {
-  /* The hash array.  */
+  /* The hash array.  This is NULL for an open addressed table.  */
   struct bfd_hash_entry **table;
+  /* The slots of an open addressed table, created by
+     bfd_hash_table_init_open_n, or NULL.  The entries of such a
+     table are not chained, so they must be visited with
+     bfd_hash_traverse rather than by walking TABLE.  */
+  struct bfd_hash_slot *slots;
   /* A function used to create new elements in the hash table.  The
      first entry is itself a pointer to an element.  When this
      function is first invoked, this pointer will be NULL.  However,
@@ -398,6 +403,22 @@ extern bfd_boolean bfd_hash_table_init_n
 			       const char *),
    unsigned int, unsigned int);
 
+/* Initialize an open addressed hash table.  */
+extern bfd_boolean bfd_hash_table_init_open
+  (struct bfd_hash_table *,
+   struct bfd_hash_entry *(*) (struct bfd_hash_entry *,
+			       struct bfd_hash_table *,
+			       const char *),
+   unsigned int);
+
+/* Initialize an open addressed hash table specifying a size.  */
+extern bfd_boolean bfd_hash_table_init_open_n
+  (struct bfd_hash_table *,
+   struct bfd_hash_entry *(*) (struct bfd_hash_entry *,
+			       struct bfd_hash_table *,
+			       const char *),
+   unsigned int, unsigned int);
+
 /* Free up a hash table.  */
 extern void bfd_hash_table_free
   (struct bfd_hash_table *);
@@ -410,6 +431,16 @@ extern struct bfd_hash_entry *bfd_hash_lookup
   (struct bfd_hash_table *, const char *, bfd_boolean create,
    bfd_boolean copy);
 
+/* Return the hash code bfd_hash_lookup computes for a string.  */
+extern unsigned long bfd_hash_string_hash
+  (struct bfd_hash_table *, const char *);
+
+/* Start fetching the memory that a lookup of a string with the given
+   hash code will examine: the bucket at STAGE 0, the entry in it at
+   STAGE 1, and the entry's string at STAGE 2.  */
+extern void bfd_hash_prefetch
+  (struct bfd_hash_table *, unsigned long, int stage);
+
 /* Insert an entry in a hash table.  */
 extern struct bfd_hash_entry *bfd_hash_insert
   (struct bfd_hash_table *, const char *, unsigned long);
@@ -445,13 +476,14 @@ extern void bfd_hash_traverse
 extern unsigned long bfd_hash_set_default_size (unsigned long);
 
 /* Types of compressed DWARF debug sections.  We currently support
-   zlib.  */
+   zlib, and zstd if BFD was configured with it.  */
 enum compressed_debug_section_type
 {
   COMPRESS_DEBUG_NONE = 0,
   COMPRESS_DEBUG = 1 << 0,
   COMPRESS_DEBUG_GNU_ZLIB = COMPRESS_DEBUG | 1 << 1,
-  COMPRESS_DEBUG_GABI_ZLIB = COMPRESS_DEBUG | 1 << 2
+  COMPRESS_DEBUG_GABI_ZLIB = COMPRESS_DEBUG | 1 << 2,
+  COMPRESS_DEBUG_ZSTD = COMPRESS_DEBUG | 1 << 3
 };
 
 /* This structure is used to keep track of stabs in sections
@@ -540,6 +572,32 @@ extern bfd_boolean bfd_cache_close
 
 extern bfd_boolean bfd_cache_close_all (void);
 
+/* Statistics kept by the file descriptor cache.  */
+
+struct bfd_cache_stats
+{
+  /* Number of files opened, and number of those reopened after the
+     cache closed them to make room for another.  */
+  unsigned long opens;
+  unsigned long reopens;
+
+  /* Number of files closed to make room for another.  */
+  unsigned long evictions;
+
+  /* Number of read-only mappings made of evicted files, and number of
+     reads served from such a mapping instead of a reopened file.  */
+  unsigned long views;
+  unsigned long view_reads;
+
+  /* Bytes currently mapped, the largest number of bytes mapped at any
+     one time, and the limit on the number of bytes mapped.  */
+  bfd_size_type view_bytes;
+  bfd_size_type view_bytes_peak;
+  bfd_size_type view_budget;
+};
+
+extern void bfd_cache_get_stats (struct bfd_cache_stats *);
+
 extern bfd_boolean bfd_record_phdr
   (bfd *, unsigned long, bfd_boolean, flagword, bfd_boolean, bfd_vma,
    bfd_boolean, bfd_boolean, unsigned int, struct bfd_section **);
@@ -6367,6 +6425,10 @@ struct bfd
      least-recently-used list of BFDs.  */
   struct bfd *lru_prev, *lru_next;
 
+  /* The caching routines may keep a read-only mapping of the file
+     here while the file itself is closed.  */
+  struct bfd_cache_view *cache_view;
+
   /* When a file is closed by the caching routines, BFD retains
      state information on the file here...  */
   ufile_ptr where;
@@ -6384,7 +6446,7 @@ struct bfd
   ENUM_BITFIELD (bfd_direction) direction : 2;
 
   /* Format_specific flags.  */
-  flagword flags : 18;
+  flagword flags : 20;
 
   /* Values that may appear in the flags field of a BFD.  These also
      appear in the object_flags field of the bfd_target structure, where
@@ -6464,16 +6526,24 @@ struct bfd
   /* Compress sections in this BFD with SHF_COMPRESSED from gABI.  */
 #define BFD_COMPRESS_GABI 0x20000
 
+  /* Read and index all of the DWARF debug information on the first
+     line number lookup, rather than reading it as needed.  */
+#define BFD_DWARF_EAGER 0x40000
+
+  /* Compress sections in this BFD with zstd rather than zlib.  Only
+     used together with BFD_COMPRESS_GABI.  */
+#define BFD_COMPRESS_ZSTD 0x80000
+
   /* Flags bits to be saved in bfd_preserve_save.  */
 #define BFD_FLAGS_SAVED \
   (BFD_IN_MEMORY | BFD_COMPRESS | BFD_DECOMPRESS | BFD_PLUGIN \
-   | BFD_COMPRESS_GABI)
+   | BFD_COMPRESS_GABI | BFD_DWARF_EAGER | BFD_COMPRESS_ZSTD)
 
   /* Flags bits which are for BFD use only.  */
 #define BFD_FLAGS_FOR_BFD_USE_MASK \
   (BFD_IN_MEMORY | BFD_COMPRESS | BFD_DECOMPRESS | BFD_LINKER_CREATED \
    | BFD_PLUGIN | BFD_TRADITIONAL_FORMAT | BFD_DETERMINISTIC_OUTPUT \
-   | BFD_COMPRESS_GABI)
+   | BFD_COMPRESS_GABI | BFD_DWARF_EAGER | BFD_COMPRESS_ZSTD)
 
   /* Is the file descriptor being cached?  That is, can it be closed as
      needed, and re-opened when accessed later?  */
@@ -6854,6 +6924,7 @@ void bfd_update_compression_header
 
 bfd_boolean bfd_check_compression_header
    (bfd *abfd, bfd_byte *contents, asection *sec,
+    unsigned int *ch_type,
     bfd_size_type *uncompressed_size);
 
 int bfd_get_compression_header_size (bfd *abfd, asection *sec);
@@ -7379,7 +7450,8 @@ void bfd_cache_section_contents
 bfd_boolean bfd_is_section_compressed_with_header
    (bfd *abfd, asection *section,
     int *compression_header_size_p,
-    bfd_size_type *uncompressed_size_p);
+    bfd_size_type *uncompressed_size_p,
+    unsigned int *ch_type_p);
 
 bfd_boolean bfd_is_section_compressed
    (bfd *abfd, asection *section);
@@ -7393,6 +7465,8 @@ bfd_boolean bfd_init_section_compress_status
 bfd_boolean bfd_compress_section
    (bfd *abfd, asection *section, bfd_byte *uncompressed_buffer);
 
+bfd_boolean bfd_zstd_supported (void);
+
 #ifdef __cplusplus
 }
 #endif
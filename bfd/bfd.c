@@ -74,6 +74,10 @@ CODE_FRAGMENT
 .     least-recently-used list of BFDs.  *}
 .  struct bfd *lru_prev, *lru_next;
 .
+.  {* The caching routines may keep a read-only mapping of the file
+.     here while the file itself is closed.  *}
+.  struct bfd_cache_view *cache_view;
+.
 .  {* When a file is closed by the caching routines, BFD retains
 .     state information on the file here...  *}
 .  ufile_ptr where;
@@ -91,7 +95,7 @@ CODE_FRAGMENT
 .  ENUM_BITFIELD (bfd_direction) direction : 2;
 .
 .  {* Format_specific flags.  *}
-.  flagword flags : 18;
+.  flagword flags : 20;
 .
 .  {* Values that may appear in the flags field of a BFD.  These also
 .     appear in the object_flags field of the bfd_target structure, where
@@ -171,16 +175,24 @@ CODE_FRAGMENT
 .  {* Compress sections in this BFD with SHF_COMPRESSED from gABI.  *}
 .#define BFD_COMPRESS_GABI 0x20000
 .
+.  {* Read and index all of the DWARF debug information on the first
+.     line number lookup, rather than reading it as needed.  *}
+.#define BFD_DWARF_EAGER 0x40000
+.
+.  {* Compress sections in this BFD with zstd rather than zlib.  Only
+.     used together with BFD_COMPRESS_GABI.  *}
+.#define BFD_COMPRESS_ZSTD 0x80000
+.
 .  {* Flags bits to be saved in bfd_preserve_save.  *}
 .#define BFD_FLAGS_SAVED \
 .  (BFD_IN_MEMORY | BFD_COMPRESS | BFD_DECOMPRESS | BFD_PLUGIN \
-.   | BFD_COMPRESS_GABI)
+.   | BFD_COMPRESS_GABI | BFD_DWARF_EAGER | BFD_COMPRESS_ZSTD)
 .
 .  {* Flags bits which are for BFD use only.  *}
 .#define BFD_FLAGS_FOR_BFD_USE_MASK \
 .  (BFD_IN_MEMORY | BFD_COMPRESS | BFD_DECOMPRESS | BFD_LINKER_CREATED \
 .   | BFD_PLUGIN | BFD_TRADITIONAL_FORMAT | BFD_DETERMINISTIC_OUTPUT \
-.   | BFD_COMPRESS_GABI)
+.   | BFD_COMPRESS_GABI | BFD_DWARF_EAGER | BFD_COMPRESS_ZSTD)
 .
 .  {* Is the file descriptor being cached?  That is, can it be closed as
 .     needed, and re-opened when accessed later?  *}
@@ -1983,6 +1995,8 @@ bfd_update_compression_header (bfd *abfd, bfd_byte *contents,
 	    {
 	      const struct elf_backend_data *bed
 		= get_elf_backend_data (abfd);
+	      unsigned int ch_type = ((abfd->flags & BFD_COMPRESS_ZSTD) != 0
+				      ? ELFCOMPRESS_ZSTD : ELFCOMPRESS_ZLIB);
 
 	      /* Set the SHF_COMPRESSED bit.  */
 	      elf_section_flags (sec) |= SHF_COMPRESSED;
@@ -1991,7 +2005,7 @@ bfd_update_compression_header (bfd *abfd, bfd_byte *contents,
 		{
 		  Elf32_External_Chdr *echdr
 		    = (Elf32_External_Chdr *) contents;
-		  bfd_put_32 (abfd, ELFCOMPRESS_ZLIB, &echdr->ch_type);
+		  bfd_put_32 (abfd, ch_type, &echdr->ch_type);
 		  bfd_put_32 (abfd, sec->size, &echdr->ch_size);
 		  bfd_put_32 (abfd, 1 << sec->alignment_power,
 			      &echdr->ch_addralign);
@@ -2000,7 +2014,7 @@ bfd_update_compression_header (bfd *abfd, bfd_byte *contents,
 		{
 		  Elf64_External_Chdr *echdr
 		    = (Elf64_External_Chdr *) contents;
-		  bfd_put_64 (abfd, ELFCOMPRESS_ZLIB, &echdr->ch_type);
+		  bfd_put_64 (abfd, ch_type, &echdr->ch_type);
 		  bfd_put_64 (abfd, sec->size, &echdr->ch_size);
 		  bfd_put_64 (abfd, 1 << sec->alignment_power,
 			      &echdr->ch_addralign);
@@ -2030,20 +2044,23 @@ bfd_update_compression_header (bfd *abfd, bfd_byte *contents,
    SYNOPSIS
 	bfd_boolean bfd_check_compression_header
 	  (bfd *abfd, bfd_byte *contents, asection *sec,
+	  unsigned int *ch_type,
 	  bfd_size_type *uncompressed_size);
 
 DESCRIPTION
 	Check the compression header at CONTENTS of SEC in ABFD and
-	store the uncompressed size in UNCOMPRESSED_SIZE if the
-	compression header is valid.
+	store the compression type in CH_TYPE and the uncompressed
+	size in UNCOMPRESSED_SIZE if the compression header is valid.
 
 RETURNS
-	Return TRUE if the compression header is valid.
+	Return TRUE if the compression header is valid and describes
+	a compression type supported by this BFD.
 */
 
 bfd_boolean
 bfd_check_compression_header (bfd *abfd, bfd_byte *contents,
 			      asection *sec,
+			      unsigned int *ch_type,
 			      bfd_size_type *uncompressed_size)
 {
   if (bfd_get_flavour (abfd) == bfd_target_elf_flavour
@@ -2065,9 +2082,14 @@ bfd_check_compression_header (bfd *abfd, bfd_byte *contents,
 	  chdr.ch_size = bfd_get_64 (abfd, &echdr->ch_size);
 	  chdr.ch_addralign = bfd_get_64 (abfd, &echdr->ch_addralign);
 	}
-      if (chdr.ch_type == ELFCOMPRESS_ZLIB
+      if ((chdr.ch_type == ELFCOMPRESS_ZLIB
+#ifdef HAVE_ZSTD
+	   || chdr.ch_type == ELFCOMPRESS_ZSTD
+#endif
+	   )
 	  && chdr.ch_addralign == 1U << sec->alignment_power)
 	{
+	  *ch_type = chdr.ch_type;
 	  *uncompressed_size = chdr.ch_size;
 	  return TRUE;
 	}
@@ -2242,14 +2264,14 @@ bfd_convert_section_contents (bfd *ibfd, sec_ptr isec, bfd *obfd,
   if (ohdr_size == sizeof (Elf32_External_Chdr))
     {
       Elf32_External_Chdr *echdr = (Elf32_External_Chdr *) contents;
-      bfd_put_32 (obfd, ELFCOMPRESS_ZLIB, &echdr->ch_type);
+      bfd_put_32 (obfd, chdr.ch_type, &echdr->ch_type);
       bfd_put_32 (obfd, chdr.ch_size, &echdr->ch_size);
       bfd_put_32 (obfd, chdr.ch_addralign, &echdr->ch_addralign);
     }
   else
     {
       Elf64_External_Chdr *echdr = (Elf64_External_Chdr *) contents;
-      bfd_put_64 (obfd, ELFCOMPRESS_ZLIB, &echdr->ch_type);
+      bfd_put_64 (obfd, chdr.ch_type, &echdr->ch_type);
       bfd_put_64 (obfd, chdr.ch_size, &echdr->ch_size);
       bfd_put_64 (obfd, chdr.ch_addralign, &echdr->ch_addralign);
     }
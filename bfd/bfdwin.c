@@ -150,10 +150,12 @@ bfd_get_file_window (bfd *abfd,
 	  abfd = abfd->my_archive;
 	}
 
-      /* Seek into the file, to ensure it is open if cacheable.  */
+      /* Seek into the file, to ensure it is open if cacheable.  A
+	 closed file the cache still has mapped must be reopened.  */
       if (abfd->iostream == NULL
 	  && (abfd->iovec == NULL
-	      || abfd->iovec->bseek (abfd, offset, SEEK_SET) != 0))
+	      || abfd->iovec->bseek (abfd, offset, SEEK_SET) != 0
+	      || (abfd->iostream == NULL && bfd_open_file (abfd) == NULL)))
 	goto free_and_fail;
 
       fd = fileno ((FILE *) abfd->iostream);
@@ -36,6 +36,15 @@ SECTION
 	close, closes it and opens the one wanted, returning its file
 	handle.
 
+	When a file opened only for reading is closed to make room
+	for another, the cache tries to keep a read-only mapping of
+	the whole file in its place.  Reads, seeks and stats of the
+	closed file are then served from the mapping, so a link with
+	many more input files than the descriptor limit does not keep
+	closing and reopening the same files.  The total size of these
+	mappings is limited by a byte budget; the least recently used
+	mapping is dropped to make room for a new one.
+
 SUBSECTION
 	Caching functions
 */
@@ -106,6 +115,34 @@ static int open_files;
 
 static bfd *bfd_last_cache = NULL;
 
+/* A read-only mapping of a file the cache has closed.  POS is the
+   file position, which is kept here rather than in the stream while
+   the file is closed.  */
+
+struct bfd_cache_view
+{
+  bfd *abfd;
+  bfd_byte *base;
+  bfd_size_type size;
+  file_ptr pos;
+  struct stat st;
+  struct bfd_cache_view *prev, *next;
+};
+
+/* The list of mappings, most recently used first.  */
+
+static struct bfd_cache_view *view_first;
+static struct bfd_cache_view *view_last;
+
+/* The limit on the number of bytes mapped at one time.  The mappings
+   are of clean file pages, so this only bounds the address space
+   used.  */
+
+#define BFD_CACHE_VIEW_BUDGET \
+  (sizeof (void *) >= 8 ? (bfd_size_type) 1 << 32 : (bfd_size_type) 1 << 28)
+
+static struct bfd_cache_stats cache_stats;
+
 /* Insert a BFD into the cache.  */
 
 static void
@@ -141,6 +178,132 @@ snip (bfd *abfd)
     }
 }
 
+/* Unlink VIEW from the list of mappings.  */
+
+static void
+view_snip (struct bfd_cache_view *view)
+{
+  if (view->prev != NULL)
+    view->prev->next = view->next;
+  else
+    view_first = view->next;
+  if (view->next != NULL)
+    view->next->prev = view->prev;
+  else
+    view_last = view->prev;
+}
+
+/* Put VIEW at the head of the list of mappings.  */
+
+static void
+view_insert (struct bfd_cache_view *view)
+{
+  view->prev = NULL;
+  view->next = view_first;
+  if (view_first != NULL)
+    view_first->prev = view;
+  else
+    view_last = view;
+  view_first = view;
+}
+
+/* Drop the mapping of ABFD, if any, leaving the file position where
+   the next reopen of the file will restore it.  */
+
+static void
+view_release (bfd *abfd)
+{
+  struct bfd_cache_view *view = abfd->cache_view;
+
+  if (view == NULL)
+    return;
+
+  abfd->where = view->pos;
+  abfd->cache_view = NULL;
+  view_snip (view);
+#ifdef HAVE_MMAP
+  munmap (view->base, view->size);
+#endif
+  cache_stats.view_bytes -= view->size;
+  free (view);
+}
+
+/* ABFD is about to be closed by the cache.  Try to map the file
+   read-only so that it can still be read while closed.  */
+
+static void
+view_create (bfd *abfd)
+{
+#ifdef HAVE_MMAP
+  struct bfd_cache_view *view;
+  FILE *f = (FILE *) abfd->iostream;
+  struct stat st;
+  void *base;
+
+  if (abfd->direction != read_direction
+      || abfd->cache_view != NULL
+      || fstat (fileno (f), &st) != 0
+      || !S_ISREG (st.st_mode)
+      || st.st_size <= 0
+      || (bfd_size_type) st.st_size > BFD_CACHE_VIEW_BUDGET
+      || (bfd_size_type) st.st_size != (size_t) st.st_size)
+    return;
+
+  while (view_last != NULL
+	 && (cache_stats.view_bytes + st.st_size > BFD_CACHE_VIEW_BUDGET))
+    view_release (view_last->abfd);
+
+  view = (struct bfd_cache_view *) bfd_malloc (sizeof (*view));
+  if (view == NULL)
+    return;
+
+  base = mmap (NULL, st.st_size, PROT_READ, MAP_PRIVATE, fileno (f), 0);
+  if (base == (void *) -1)
+    {
+      free (view);
+      return;
+    }
+
+  view->abfd = abfd;
+  view->base = (bfd_byte *) base;
+  view->size = st.st_size;
+  view->pos = abfd->where;
+  view->st = st;
+  view_insert (view);
+  abfd->cache_view = view;
+
+  ++cache_stats.views;
+  cache_stats.view_bytes += view->size;
+  if (cache_stats.view_bytes_peak < cache_stats.view_bytes)
+    cache_stats.view_bytes_peak = cache_stats.view_bytes;
+#else
+  (void) abfd;
+#endif
+}
+
+/* Return the mapping to be used in place of the stream for ABFD, or
+   NULL if ABFD should be read through its stream.  */
+
+static struct bfd_cache_view *
+view_lookup (bfd *abfd)
+{
+  struct bfd_cache_view *view;
+
+  while (abfd->my_archive)
+    abfd = abfd->my_archive;
+
+  view = abfd->cache_view;
+  if (view == NULL || abfd->iostream != NULL)
+    return NULL;
+
+  if (view != view_first)
+    {
+      view_snip (view);
+      view_insert (view);
+    }
+  return view;
+}
+
 /* Close a BFD and remove it from the cache.  */
 
 static bfd_boolean
@@ -195,6 +358,8 @@ close_one (void)
     }
 
   to_kill->where = real_ftell ((FILE *) to_kill->iostream);
+  view_create (to_kill);
+  ++cache_stats.evictions;
 
   return bfd_cache_delete (to_kill);
 }
@@ -240,6 +405,7 @@ bfd_cache_lookup_worker (bfd *abfd, enum cache_flag flag)
   if (flag & CACHE_NO_OPEN)
     return NULL;
 
+  ++cache_stats.reopens;
   if (bfd_open_file (abfd) == NULL)
     ;
   else if (!(flag & CACHE_NO_SEEK)
@@ -257,7 +423,12 @@ bfd_cache_lookup_worker (bfd *abfd, enum cache_flag flag)
 static file_ptr
 cache_btell (struct bfd *abfd)
 {
-  FILE *f = bfd_cache_lookup (abfd, CACHE_NO_OPEN);
+  struct bfd_cache_view *view = view_lookup (abfd);
+  FILE *f;
+
+  if (view != NULL)
+    return view->pos;
+  f = bfd_cache_lookup (abfd, CACHE_NO_OPEN);
   if (f == NULL)
     return abfd->where;
   return real_ftell (f);
@@ -266,7 +437,25 @@ cache_btell (struct bfd *abfd)
 static int
 cache_bseek (struct bfd *abfd, file_ptr offset, int whence)
 {
-  FILE *f = bfd_cache_lookup (abfd, whence != SEEK_CUR ? CACHE_NO_SEEK : CACHE_NORMAL);
+  struct bfd_cache_view *view = view_lookup (abfd);
+  FILE *f;
+
+  if (view != NULL)
+    {
+      if (whence == SEEK_CUR)
+	offset += view->pos;
+      else if (whence == SEEK_END)
+	offset += view->size;
+      if (offset < 0)
+	{
+	  bfd_set_error (bfd_error_system_call);
+	  return -1;
+	}
+      view->pos = offset;
+      return 0;
+    }
+
+  f = bfd_cache_lookup (abfd, whence != SEEK_CUR ? CACHE_NO_SEEK : CACHE_NORMAL);
   if (f == NULL)
     return -1;
   return real_fseek (f, offset, whence);
@@ -333,8 +522,25 @@ cache_bread_1 (struct bfd *abfd, void *buf, file_ptr nbytes)
 static file_ptr
 cache_bread (struct bfd *abfd, void *buf, file_ptr nbytes)
 {
+  struct bfd_cache_view *view = view_lookup (abfd);
   file_ptr nread = 0;
 
+  if (view != NULL)
+    {
+      if ((bfd_size_type) view->pos < view->size)
+	{
+	  nread = view->size - view->pos;
+	  if (nread > nbytes)
+	    nread = nbytes;
+	  memcpy (buf, view->base + view->pos, nread);
+	  view->pos += nread;
+	}
+      ++cache_stats.view_reads;
+      if (nread < nbytes)
+	bfd_set_error (bfd_error_file_truncated);
+      return nread;
+    }
+
   /* Some filesystems are unable to handle reads that are too large
      (for instance, NetApp shares with oplocks turned off).  To avoid
      hitting this limitation, we read the buffer in chunks of 8MB max.  */
@@ -407,9 +613,17 @@ cache_bflush (struct bfd *abfd)
 static int
 cache_bstat (struct bfd *abfd, struct stat *sb)
 {
+  struct bfd_cache_view *view = view_lookup (abfd);
   int sts;
-  FILE *f = bfd_cache_lookup (abfd, CACHE_NO_SEEK_ERROR);
+  FILE *f;
+
+  if (view != NULL)
+    {
+      *sb = view->st;
+      return 0;
+    }
 
+  f = bfd_cache_lookup (abfd, CACHE_NO_SEEK_ERROR);
   if (f == NULL)
     return -1;
   sts = fstat (fileno (f), sb);
@@ -499,6 +713,7 @@ bfd_cache_init (bfd *abfd)
   abfd->iovec = &cache_iovec;
   insert (abfd);
   ++open_files;
+  ++cache_stats.opens;
   return TRUE;
 }
 
@@ -524,6 +739,8 @@ bfd_cache_close (bfd *abfd)
   if (abfd->iovec != &cache_iovec)
     return TRUE;
 
+  view_release (abfd);
+
   if (abfd->iostream == NULL)
     /* Previously closed.  */
     return TRUE;
@@ -555,9 +772,31 @@ bfd_cache_close_all ()
   while (bfd_last_cache != NULL)
     ret &= bfd_cache_close (bfd_last_cache);
 
+  while (view_first != NULL)
+    view_release (view_first->abfd);
+
   return ret;
 }
 
+/*
+FUNCTION
+	bfd_cache_get_stats
+
+SYNOPSIS
+	void bfd_cache_get_stats (struct bfd_cache_stats *stats);
+
+DESCRIPTION
+	Fill in @var{stats} with counts of the files the cache has
+	opened, closed and mapped so far.
+*/
+
+void
+bfd_cache_get_stats (struct bfd_cache_stats *stats)
+{
+  *stats = cache_stats;
+  stats->view_budget = BFD_CACHE_VIEW_BUDGET;
+}
+
 /*
 INTERNAL_FUNCTION
 	bfd_open_file
@@ -576,8 +815,17 @@ DESCRIPTION
 FILE *
 bfd_open_file (bfd *abfd)
 {
+  file_ptr pos = -1;
+
   abfd->cacheable = TRUE;	/* Allow it to be closed later.  */
 
+  /* Carry the position of a mapped file over to the new stream.  */
+  if (abfd->cache_view != NULL)
+    {
+      pos = abfd->cache_view->pos;
+      view_release (abfd);
+    }
+
   if (open_files >= bfd_cache_max_open ())
     {
       if (! close_one ())
@@ -638,6 +886,8 @@ bfd_open_file (bfd *abfd)
     {
       if (! bfd_cache_init (abfd))
 	return NULL;
+      if (pos > 0)
+	real_fseek ((FILE *) abfd->iostream, pos, SEEK_SET);
     }
 
   return (FILE *) abfd->iostream;
@@ -20,14 +20,19 @@
 
 #include "sysdep.h"
 #include <zlib.h>
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
 #include "bfd.h"
 #include "libbfd.h"
 #include "safe-ctype.h"
+#include "elf/common.h"
 
 #define MAX_COMPRESSION_HEADER_SIZE 24
 
 static bfd_boolean
-decompress_contents (bfd_byte *compressed_buffer,
+decompress_contents (unsigned int ch_type,
+		     bfd_byte *compressed_buffer,
 		     bfd_size_type compressed_size,
 		     bfd_byte *uncompressed_buffer,
 		     bfd_size_type uncompressed_size)
@@ -35,6 +40,19 @@ decompress_contents (bfd_byte *compressed_buffer,
   z_stream strm;
   int rc;
 
+  if (ch_type == ELFCOMPRESS_ZSTD)
+    {
+#ifdef HAVE_ZSTD
+      size_t ret = ZSTD_decompress (uncompressed_buffer, uncompressed_size,
+				    compressed_buffer, compressed_size);
+      return !ZSTD_isError (ret) && ret == uncompressed_size;
+#else
+      return FALSE;
+#endif
+    }
+  else if (ch_type != ELFCOMPRESS_ZLIB)
+    return FALSE;
+
   /* It is possible the section consists of several compressed
      buffers concatenated together, so we uncompress in a loop.  */
   /* PR 18313: The state field in the z_stream structure is supposed
@@ -84,16 +102,69 @@ bfd_compress_section_contents (bfd *abfd, sec_ptr sec,
   int zlib_size = 0;
   int orig_compression_header_size;
   bfd_size_type orig_uncompressed_size;
+  unsigned int orig_ch_type;
+  unsigned int ch_type;
   int header_size = bfd_get_compression_header_size (abfd, NULL);
   bfd_boolean compressed
     = bfd_is_section_compressed_with_header (abfd, sec,
 					     &orig_compression_header_size,
-					     &orig_uncompressed_size);
+					     &orig_uncompressed_size,
+					     &orig_ch_type);
 
   /* Either ELF compression header or the 12-byte, "ZLIB" + 8-byte size,
-     overhead in .zdebug* section.  */
+     overhead in .zdebug* section.  Only the ELF compression header can
+     describe zstd.  */
   if (!header_size)
-     header_size = 12;
+    {
+      header_size = 12;
+      ch_type = ELFCOMPRESS_ZLIB;
+    }
+  else if ((abfd->flags & BFD_COMPRESS_ZSTD) != 0)
+    ch_type = ELFCOMPRESS_ZSTD;
+  else
+    ch_type = ELFCOMPRESS_ZLIB;
+
+#ifndef HAVE_ZSTD
+  if (ch_type == ELFCOMPRESS_ZSTD)
+    {
+      bfd_set_error (bfd_error_invalid_operation);
+      return 0;
+    }
+#endif
+
+  if (compressed && orig_ch_type != ch_type)
+    {
+      /* A different compression algorithm.  Decompress the section
+	 and compress it again.  */
+      bfd_byte *orig_buffer;
+
+      if (orig_compression_header_size < 0)
+	abort ();
+
+      /* A .zdebug* section has the 12-byte "ZLIB" header.  */
+      if (orig_compression_header_size == 0)
+	orig_compression_header_size = 12;
+
+      orig_buffer = (bfd_byte *) bfd_malloc (orig_uncompressed_size);
+      if (orig_buffer == NULL)
+	return 0;
+      if (!decompress_contents (orig_ch_type,
+				uncompressed_buffer
+				+ orig_compression_header_size,
+				uncompressed_size
+				- orig_compression_header_size,
+				orig_buffer, orig_uncompressed_size))
+	{
+	  bfd_set_error (bfd_error_bad_value);
+	  free (orig_buffer);
+	  return 0;
+	}
+      free (uncompressed_buffer);
+      uncompressed_buffer = orig_buffer;
+      uncompressed_size = orig_uncompressed_size;
+      sec->size = uncompressed_size;
+      compressed = FALSE;
+    }
 
   if (compressed)
     {
@@ -121,6 +192,10 @@ bfd_compress_section_contents (bfd *abfd, sec_ptr sec,
       /* Add the header size.  */
       compressed_size = zlib_size + header_size;
     }
+#ifdef HAVE_ZSTD
+  else if (ch_type == ELFCOMPRESS_ZSTD)
+    compressed_size = ZSTD_compressBound (uncompressed_size) + header_size;
+#endif
   else
     compressed_size = compressBound (uncompressed_size) + header_size;
 
@@ -144,7 +219,8 @@ bfd_compress_section_contents (bfd *abfd, sec_ptr sec,
       sec->size = orig_uncompressed_size;
       if (decompress)
 	{
-	  if (!decompress_contents (uncompressed_buffer
+	  if (!decompress_contents (orig_ch_type,
+				    uncompressed_buffer
 				    + orig_compression_header_size,
 				    zlib_size, buffer, buffer_size))
 	    {
@@ -167,6 +243,24 @@ bfd_compress_section_contents (bfd *abfd, sec_ptr sec,
     }
   else
     {
+#ifdef HAVE_ZSTD
+      if (ch_type == ELFCOMPRESS_ZSTD)
+	{
+	  size_t size = ZSTD_compress (buffer + header_size,
+				       compressed_size - header_size,
+				       uncompressed_buffer,
+				       uncompressed_size,
+				       ZSTD_CLEVEL_DEFAULT);
+	  if (ZSTD_isError (size))
+	    {
+	      bfd_release (abfd, buffer);
+	      bfd_set_error (bfd_error_bad_value);
+	      return 0;
+	    }
+	  compressed_size = size;
+	}
+      else
+#endif
       if (compress ((Bytef*) buffer + header_size,
 		    &compressed_size,
 		    (const Bytef*) uncompressed_buffer,
@@ -229,6 +323,8 @@ bfd_get_full_section_contents (bfd *abfd, sec_ptr sec, bfd_byte **ptr)
   bfd_size_type save_rawsize;
   bfd_byte *compressed_buffer;
   unsigned int compression_header_size;
+  unsigned int ch_type;
+  bfd_size_type ch_size;
 
   if (abfd->direction != write_direction && sec->rawsize != 0)
     sz = sec->rawsize;
@@ -288,11 +384,20 @@ bfd_get_full_section_contents (bfd *abfd, sec_ptr sec, bfd_byte **ptr)
 
       compression_header_size = bfd_get_compression_header_size (abfd, sec);
       if (compression_header_size == 0)
-	/* Set header size to the zlib header size if it is a
-	   SHF_COMPRESSED section.  */
-	compression_header_size = 12;
-      if (!decompress_contents (compressed_buffer + compression_header_size,
-				sec->compressed_size, p, sz))
+	{
+	  /* Set header size to the zlib header size if it is not a
+	     SHF_COMPRESSED section.  */
+	  compression_header_size = 12;
+	  ch_type = ELFCOMPRESS_ZLIB;
+	}
+      else if (!bfd_check_compression_header (abfd, compressed_buffer, sec,
+					      &ch_type, &ch_size))
+	ch_type = 0;
+      if (sec->compressed_size < compression_header_size
+	  || !decompress_contents (ch_type,
+				   compressed_buffer + compression_header_size,
+				   sec->compressed_size - compression_header_size,
+				   p, sz))
 	{
 	  bfd_set_error (bfd_error_bad_value);
 	  if (p != *ptr)
@@ -356,20 +461,24 @@ SYNOPSIS
 	bfd_boolean bfd_is_section_compressed_with_header
 	  (bfd *abfd, asection *section,
 	  int *compression_header_size_p,
-	  bfd_size_type *uncompressed_size_p);
+	  bfd_size_type *uncompressed_size_p,
+	  unsigned int *ch_type_p);
 
 DESCRIPTION
 	Return @code{TRUE} if @var{section} is compressed.  Compression
-	header size is returned in @var{compression_header_size_p} and
-	uncompressed size is returned in @var{uncompressed_size_p}.  If
-	compression is unsupported, compression header size is returned
-	with -1 and uncompressed size is returned with 0.
+	header size is returned in @var{compression_header_size_p},
+	uncompressed size is returned in @var{uncompressed_size_p} and
+	the ELF compression type, ELFCOMPRESS_ZLIB for .zdebug*
+	sections, is returned in @var{ch_type_p}.  If compression is
+	unsupported, compression header size is returned with -1 and
+	uncompressed size is returned with 0.
 */
 
 bfd_boolean
 bfd_is_section_compressed_with_header (bfd *abfd, sec_ptr sec,
 				       int *compression_header_size_p,
-				       bfd_size_type *uncompressed_size_p)
+				       bfd_size_type *uncompressed_size_p,
+				       unsigned int *ch_type_p)
 {
   bfd_byte header[MAX_COMPRESSION_HEADER_SIZE];
   int compression_header_size;
@@ -399,11 +508,12 @@ bfd_is_section_compressed_with_header (bfd *abfd, sec_ptr sec,
     compressed = FALSE;
 
   *uncompressed_size_p = sec->size;
+  *ch_type_p = ELFCOMPRESS_ZLIB;
   if (compressed)
     {
       if (compression_header_size != 0)
 	{
-	  if (!bfd_check_compression_header (abfd, header, sec,
+	  if (!bfd_check_compression_header (abfd, header, sec, ch_type_p,
 					     uncompressed_size_p))
 	    compression_header_size = -1;
 	}
@@ -441,9 +551,11 @@ bfd_is_section_compressed (bfd *abfd, sec_ptr sec)
 {
   int compression_header_size;
   bfd_size_type uncompressed_size;
+  unsigned int ch_type;
   return (bfd_is_section_compressed_with_header (abfd, sec,
 						 &compression_header_size,
-						 &uncompressed_size)
+						 &uncompressed_size,
+						 &ch_type)
 	  && compression_header_size >= 0
 	  && uncompressed_size > 0);
 }
@@ -472,6 +584,7 @@ bfd_init_section_decompress_status (bfd *abfd, sec_ptr sec)
   int compression_header_size;
   int header_size;
   bfd_size_type uncompressed_size;
+  unsigned int ch_type;
 
   compression_header_size = bfd_get_compression_header_size (abfd, sec);
   if (compression_header_size > MAX_COMPRESSION_HEADER_SIZE)
@@ -499,7 +612,7 @@ bfd_init_section_decompress_status (bfd *abfd, sec_ptr sec)
 	}
       uncompressed_size = bfd_getb64 (header + 4);
     }
-  else if (!bfd_check_compression_header (abfd, header, sec,
+  else if (!bfd_check_compression_header (abfd, header, sec, &ch_type,
 					 &uncompressed_size))
     {
       bfd_set_error (bfd_error_wrong_format);
@@ -601,3 +714,25 @@ bfd_compress_section (bfd *abfd, sec_ptr sec, bfd_byte *uncompressed_buffer)
   return bfd_compress_section_contents (abfd, sec, uncompressed_buffer,
 					uncompressed_size) != 0;
 }
+
+/*
+FUNCTION
+	bfd_zstd_supported
+
+SYNOPSIS
+	bfd_boolean bfd_zstd_supported (void);
+
+DESCRIPTION
+	Return @code{TRUE} if BFD was configured with zstd, so that
+	sections can be compressed with and decompressed from zstd.
+*/
+
+bfd_boolean
+bfd_zstd_supported (void)
+{
+#ifdef HAVE_ZSTD
+  return TRUE;
+#else
+  return FALSE;
+#endif
+}
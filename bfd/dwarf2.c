@@ -188,6 +188,41 @@ struct dwarf2_debug
 
   /* True if we opened bfd_ptr.  */
   bfd_boolean close_on_cleanup;
+
+  /* When BFD_DWARF_EAGER is set, an array of the address ranges of
+     all the compilation units, sorted by address.  */
+  struct lookup_comp_unit *unit_lookup_table;
+
+  /* Number of entries in UNIT_LOOKUP_TABLE.  */
+  unsigned int unit_lookup_count;
+
+  /* When BFD_DWARF_EAGER is set, the compilation units which have no
+     address ranges, and so must always be checked.  */
+  struct lookup_comp_unit *unranged_units;
+
+  /* Number of entries in UNRANGED_UNITS.  */
+  unsigned int unranged_unit_count;
+
+  /* Scratch space for collecting the units to check for an address,
+     with room for every compilation unit.  */
+  struct lookup_comp_unit **unit_candidates;
+
+  /* True if all the compilation units have been read and indexed.  */
+  bfd_boolean units_indexed;
+};
+
+/* An entry in the array of compilation unit address ranges.  */
+
+struct lookup_comp_unit
+{
+  /* The compilation unit.  */
+  struct comp_unit *unit;
+  /* The address range.  HIGH_ADDR is the highest address of this
+     range and of every range sorted before it.  */
+  bfd_vma low_addr;
+  bfd_vma high_addr;
+  /* The position of the unit in the all_comp_units list.  */
+  unsigned int idx;
 };
 
 struct arange
@@ -256,6 +291,13 @@ struct comp_unit
   /* A list of the functions found in this comp. unit.  */
   struct funcinfo *function_table;
 
+  /* An array of the functions in FUNCTION_TABLE sorted by address,
+     built on the first address lookup.  */
+  struct lookup_funcinfo *lookup_funcinfo_table;
+
+  /* Number of entries in LOOKUP_FUNCINFO_TABLE.  */
+  unsigned int number_of_functions;
+
   /* A list of the variables found in this comp. unit.  */
   struct varinfo *variable_table;
 
@@ -1236,6 +1278,8 @@ struct line_sequence
   bfd_vma               low_pc;
   struct line_sequence* prev_sequence;
   struct line_info*     last_line;  /* Largest VMA.  */
+  struct line_info**    line_info_lookup;  /* Lines sorted by VMA.  */
+  unsigned int          num_lines;  /* Entries in LINE_INFO_LOOKUP.  */
 };
 
 struct line_info_table
@@ -1278,6 +1322,22 @@ struct funcinfo
   asection *sec;
 };
 
+/* An entry in a comp_unit's array of functions sorted by address.  */
+
+struct lookup_funcinfo
+{
+  /* The function.  */
+  struct funcinfo *funcinfo;
+  /* The lowest address of all of the function's ranges.  */
+  bfd_vma low_addr;
+  /* The highest address of the ranges of this function and of every
+     function sorted before it.  */
+  bfd_vma high_addr;
+  /* The position of the function in the function_table list, used to
+     break ties the same way as walking the list.  */
+  unsigned int idx;
+};
+
 struct varinfo
 {
   /* Pointer to previous variable in list of all variables */
@@ -1386,6 +1446,8 @@ add_line_info (struct line_info_table *table,
       seq->low_pc = address;
       seq->prev_sequence = table->sequences;
       seq->last_line = info;
+      seq->line_info_lookup = NULL;
+      seq->num_lines = 0;
       table->lcl_head = info;
       table->sequences = seq;
       table->num_sequences++;
@@ -1609,6 +1671,8 @@ sort_line_sequences (struct line_info_table* table)
       sequences[n].low_pc = seq->low_pc;
       sequences[n].prev_sequence = NULL;
       sequences[n].last_line = seq->last_line;
+      sequences[n].line_info_lookup = NULL;
+      sequences[n].num_lines = 0;
       seq = seq->prev_sequence;
       free (last_seq);
     }
@@ -1646,6 +1710,52 @@ sort_line_sequences (struct line_info_table* table)
   return TRUE;
 }
 
+/* Build the array of lines in SEQ sorted by increasing address, for
+   binary searching, if it has not been built already.  */
+
+static bfd_boolean
+build_line_info_table (struct line_info_table *table,
+		       struct line_sequence *seq)
+{
+  bfd_size_type amt;
+  struct line_info **line_info_lookup;
+  struct line_info *each_line;
+  unsigned int num_lines;
+  unsigned int line_index;
+
+  if (seq->line_info_lookup != NULL)
+    return TRUE;
+
+  /* Count the number of line information entries.  We could do this
+     while scanning the debug information, but some sequences are
+     never looked up.  */
+  num_lines = 0;
+  for (each_line = seq->last_line; each_line; each_line = each_line->prev_line)
+    num_lines++;
+
+  if (num_lines == 0)
+    return TRUE;
+
+  /* Allocate space for the line information lookup table.  */
+  amt = sizeof (struct line_info*) * num_lines;
+  line_info_lookup = (struct line_info**) bfd_alloc (table->abfd, amt);
+  if (line_info_lookup == NULL)
+    return FALSE;
+
+  /* The list is sorted by decreasing address, so fill the array from
+     the end.  */
+  line_index = num_lines;
+  for (each_line = seq->last_line; each_line; each_line = each_line->prev_line)
+    line_info_lookup[--line_index] = each_line;
+
+  BFD_ASSERT (line_index == 0);
+
+  seq->num_lines = num_lines;
+  seq->line_info_lookup = line_info_lookup;
+
+  return TRUE;
+}
+
 /* Decode the line number information for UNIT.  */
 
 static struct line_info_table*
@@ -2089,7 +2199,7 @@ lookup_address_in_line_info_table (struct line_info_table *table,
 				   unsigned int *discriminator_ptr)
 {
   struct line_sequence *seq = NULL;
-  struct line_info *each_line;
+  struct line_info *info;
   int low, high, mid;
 
   /* Binary search the array of sequences.  */
@@ -2109,20 +2219,34 @@ lookup_address_in_line_info_table (struct line_info_table *table,
 
   if (seq && addr >= seq->low_pc && addr < seq->last_line->address)
     {
-      /* Note: seq->last_line should be a descendingly sorted list.  */
-      for (each_line = seq->last_line;
-	   each_line;
-	   each_line = each_line->prev_line)
-	if (addr >= each_line->address)
-	  break;
+      if (!build_line_info_table (table, seq))
+	{
+	  *filename_ptr = NULL;
+	  return 0;
+	}
 
-      if (each_line
-	  && !(each_line->end_sequence || each_line == seq->last_line))
+      /* Binary search the array of lines for the last one whose
+	 address is not above ADDR.  This is the first line found by
+	 walking the descendingly sorted list from seq->last_line.  */
+      low = 0;
+      high = seq->num_lines;
+      while (low < high)
 	{
-	  *filename_ptr = each_line->filename;
-	  *linenumber_ptr = each_line->line;
+	  mid = (low + high) / 2;
+	  if (addr < seq->line_info_lookup[mid]->address)
+	    high = mid;
+	  else
+	    low = mid + 1;
+	}
+
+      info = low > 0 ? seq->line_info_lookup[low - 1] : NULL;
+      if (info
+	  && !(info->end_sequence || info == seq->last_line))
+	{
+	  *filename_ptr = info->filename;
+	  *linenumber_ptr = info->line;
 	  if (discriminator_ptr)
-	    *discriminator_ptr = each_line->discriminator;
+	    *discriminator_ptr = info->discriminator;
 	  return seq->last_line->address - seq->low_pc;
 	}
     }
@@ -2144,6 +2268,105 @@ read_debug_ranges (struct comp_unit *unit)
 
 /* Function table functions.  */
 
+/* Compare function for the function lookup table.  */
+
+static int
+compare_lookup_funcinfos (const void * a, const void * b)
+{
+  const struct lookup_funcinfo * lookup1 = a;
+  const struct lookup_funcinfo * lookup2 = b;
+
+  if (lookup1->low_addr < lookup2->low_addr)
+    return -1;
+  if (lookup1->low_addr > lookup2->low_addr)
+    return 1;
+  if (lookup1->high_addr < lookup2->high_addr)
+    return -1;
+  if (lookup1->high_addr > lookup2->high_addr)
+    return 1;
+
+  /* Keep the sort stable.  */
+  if (lookup1->idx < lookup2->idx)
+    return -1;
+  if (lookup1->idx > lookup2->idx)
+    return 1;
+  return 0;
+}
+
+/* Build UNIT's array of functions sorted by address, if it has not
+   been built already.  */
+
+static bfd_boolean
+build_lookup_funcinfo_table (struct comp_unit * unit)
+{
+  struct lookup_funcinfo *lookup_funcinfo_table = unit->lookup_funcinfo_table;
+  unsigned int number_of_functions = unit->number_of_functions;
+  struct funcinfo *each;
+  struct lookup_funcinfo *entry;
+  size_t func_index;
+  struct arange *range;
+  bfd_vma low_addr, high_addr;
+
+  if (lookup_funcinfo_table || number_of_functions == 0)
+    return TRUE;
+
+  /* Create the function info lookup table.  */
+  lookup_funcinfo_table = (struct lookup_funcinfo *)
+    bfd_alloc (unit->abfd,
+	       number_of_functions * sizeof (struct lookup_funcinfo));
+  if (lookup_funcinfo_table == NULL)
+    return FALSE;
+
+  /* Populate the function info lookup table.  */
+  func_index = 0;
+  for (each = unit->function_table; each; each = each->prev_func)
+    {
+      entry = &lookup_funcinfo_table[func_index];
+      entry->funcinfo = each;
+      entry->idx = func_index;
+
+      /* Calculate the lowest and highest address for this function.  */
+      low_addr  = entry->funcinfo->arange.low;
+      high_addr = entry->funcinfo->arange.high;
+
+      for (range = entry->funcinfo->arange.next; range; range = range->next)
+	{
+	  if (range->low < low_addr)
+	    low_addr = range->low;
+	  if (range->high > high_addr)
+	    high_addr = range->high;
+	}
+
+      entry->low_addr = low_addr;
+      entry->high_addr = high_addr;
+      func_index++;
+    }
+
+  BFD_ASSERT (func_index == number_of_functions);
+
+  /* Sort the function by address.  */
+  qsort (lookup_funcinfo_table,
+	 number_of_functions,
+	 sizeof (struct lookup_funcinfo),
+	 compare_lookup_funcinfos);
+
+  /* Make HIGH_ADDR the highest address seen so far, so that the
+     array can be binary searched for the first function which might
+     contain a given address.  */
+  high_addr = lookup_funcinfo_table[0].high_addr;
+  for (func_index = 1; func_index < number_of_functions; func_index++)
+    {
+      entry = &lookup_funcinfo_table[func_index];
+      if (entry->high_addr > high_addr)
+	high_addr = entry->high_addr;
+      else
+	entry->high_addr = high_addr;
+    }
+
+  unit->lookup_funcinfo_table = lookup_funcinfo_table;
+  return TRUE;
+}
+
 /* If ADDR is within UNIT's function tables, set FUNCTION_PTR, and return
    TRUE.  Note that we need to find the function that has the smallest range
    that contains ADDR, to handle inlined functions without depending upon
@@ -2154,37 +2377,73 @@ lookup_address_in_function_table (struct comp_unit *unit,
 				  bfd_vma addr,
 				  struct funcinfo **function_ptr)
 {
-  struct funcinfo* each_func;
+  unsigned int number_of_functions = unit->number_of_functions;
+  struct lookup_funcinfo* lookup_funcinfo = NULL;
+  struct funcinfo* funcinfo = NULL;
   struct funcinfo* best_fit = NULL;
   bfd_vma best_fit_len = 0;
+  unsigned int best_fit_idx = 0;
+  bfd_size_type low, high, mid, first;
   struct arange *arange;
 
-  for (each_func = unit->function_table;
-       each_func;
-       each_func = each_func->prev_func)
+  if (number_of_functions == 0)
+    return FALSE;
+
+  if (!build_lookup_funcinfo_table (unit))
+    return FALSE;
+
+  /* Find the first function in the lookup table which may contain the
+     specified address.  */
+  low = 0;
+  high = number_of_functions;
+  first = high;
+  while (low < high)
     {
-      for (arange = &each_func->arange;
-	   arange;
-	   arange = arange->next)
+      mid = (low + high) / 2;
+      lookup_funcinfo = &unit->lookup_funcinfo_table[mid];
+      if (addr < lookup_funcinfo->low_addr)
+	high = mid;
+      else if (addr >= lookup_funcinfo->high_addr)
+	low = mid + 1;
+      else
+	high = first = mid;
+    }
+
+  /* Find the function with the smallest range containing the
+     address.  When two ranges have the same length, pick the
+     function which comes first in the function_table list, as
+     walking that list would.  */
+  while (first < number_of_functions)
+    {
+      lookup_funcinfo = &unit->lookup_funcinfo_table[first];
+      if (addr < lookup_funcinfo->low_addr)
+	break;
+      funcinfo = lookup_funcinfo->funcinfo;
+
+      for (arange = &funcinfo->arange; arange; arange = arange->next)
 	{
-	  if (addr >= arange->low && addr < arange->high)
+	  if (addr < arange->low || addr >= arange->high)
+	    continue;
+
+	  if (!best_fit
+	      || arange->high - arange->low < best_fit_len
+	      || (arange->high - arange->low == best_fit_len
+		  && lookup_funcinfo->idx < best_fit_idx))
 	    {
-	      if (!best_fit
-		  || arange->high - arange->low < best_fit_len)
-		{
-		  best_fit = each_func;
-		  best_fit_len = arange->high - arange->low;
-		}
+	      best_fit = funcinfo;
+	      best_fit_len = arange->high - arange->low;
+	      best_fit_idx = lookup_funcinfo->idx;
 	    }
 	}
-    }
 
-  if (best_fit)
-    {
-      *function_ptr = best_fit;
-      return TRUE;
+      first++;
     }
-  return FALSE;
+
+  if (!best_fit)
+    return FALSE;
+
+  *function_ptr = best_fit;
+  return TRUE;
 }
 
 /* If SYM at ADDR is within function table of UNIT, set FILENAME_PTR
@@ -2513,6 +2772,7 @@ scan_unit_for_symbols (struct comp_unit *unit)
 	  func->tag = abbrev->tag;
 	  func->prev_func = unit->function_table;
 	  unit->function_table = func;
+	  unit->number_of_functions++;
 	  BFD_ASSERT (!unit->cached);
 
 	  if (func->tag == DW_TAG_inlined_subroutine)
@@ -3839,6 +4099,298 @@ _bfd_dwarf2_find_symbol_bias (asymbol ** symbols, void ** pinfo)
   return 0;
 }
 
+/* Read the next compilation unit from the .debug_info sections of
+   STASH and add it to the list of units.  Return the new unit, or
+   NULL if there was nothing but a zero length header to read.  Set
+   *STOP if the debug information is damaged and no more should be
+   read.  */
+
+static struct comp_unit *
+read_next_comp_unit (struct dwarf2_debug *stash, unsigned int addr_size,
+		     const struct dwarf_debug_section *debug_sections,
+		     bfd_boolean *stop)
+{
+  bfd_vma length;
+  unsigned int offset_size;
+  bfd_byte *info_ptr_unit = stash->info_ptr;
+  struct comp_unit *each;
+  bfd_byte *new_ptr;
+
+  *stop = FALSE;
+
+  /* The DWARF2 spec says that the initial length field, and the
+     offset of the abbreviation table, should both be 4-byte values.
+     However, some compilers do things differently.  */
+  if (addr_size == 0)
+    addr_size = 4;
+  BFD_ASSERT (addr_size == 4 || addr_size == 8);
+  offset_size = addr_size;
+
+  length = read_4_bytes (stash->bfd_ptr, stash->info_ptr, stash->info_ptr_end);
+  /* A 0xffffff length is the DWARF3 way of indicating
+     we use 64-bit offsets, instead of 32-bit offsets.  */
+  if (length == 0xffffffff)
+    {
+      offset_size = 8;
+      length = read_8_bytes (stash->bfd_ptr, stash->info_ptr + 4, stash->info_ptr_end);
+      stash->info_ptr += 12;
+    }
+  /* A zero length is the IRIX way of indicating 64-bit offsets,
+     mostly because the 64-bit length will generally fit in 32
+     bits, and the endianness helps.  */
+  else if (length == 0)
+    {
+      offset_size = 8;
+      length = read_4_bytes (stash->bfd_ptr, stash->info_ptr + 4, stash->info_ptr_end);
+      stash->info_ptr += 8;
+    }
+  /* In the absence of the hints above, we assume 32-bit DWARF2
+     offsets even for targets with 64-bit addresses, because:
+       a) most of the time these targets will not have generated
+	  more than 2Gb of debug info and so will not need 64-bit
+	  offsets,
+     and
+       b) if they do use 64-bit offsets but they are not using
+	  the size hints that are tested for above then they are
+	  not conforming to the DWARF3 standard anyway.  */
+  else if (addr_size == 8)
+    {
+      offset_size = 4;
+      stash->info_ptr += 4;
+    }
+  else
+    stash->info_ptr += 4;
+
+  if (length == 0)
+    return NULL;
+
+  each = parse_comp_unit (stash, length, info_ptr_unit, offset_size);
+  if (!each)
+    {
+      /* The dwarf information is damaged, don't trust it any
+	 more.  */
+      *stop = TRUE;
+      return NULL;
+    }
+
+  new_ptr = stash->info_ptr + length;
+  /* PR 17512: file: 1500698c.  */
+  if (new_ptr < stash->info_ptr)
+    {
+      /* A corrupt length value - do not trust the info any more.  */
+      *stop = TRUE;
+      return NULL;
+    }
+  stash->info_ptr = new_ptr;
+
+  if (stash->all_comp_units)
+    stash->all_comp_units->prev_unit = each;
+  else
+    stash->last_comp_unit = each;
+
+  each->next_unit = stash->all_comp_units;
+  stash->all_comp_units = each;
+
+  if ((bfd_vma) (stash->info_ptr - stash->sec_info_ptr)
+      == stash->sec->size)
+    {
+      stash->sec = find_debug_info (stash->bfd_ptr, debug_sections,
+				    stash->sec);
+      stash->sec_info_ptr = stash->info_ptr;
+    }
+
+  return each;
+}
+
+/* Compare function for the compilation unit lookup table.  */
+
+static int
+compare_lookup_comp_units (const void *a, const void *b)
+{
+  const struct lookup_comp_unit *lookup1 = a;
+  const struct lookup_comp_unit *lookup2 = b;
+
+  if (lookup1->low_addr < lookup2->low_addr)
+    return -1;
+  if (lookup1->low_addr > lookup2->low_addr)
+    return 1;
+  if (lookup1->idx < lookup2->idx)
+    return -1;
+  if (lookup1->idx > lookup2->idx)
+    return 1;
+  return 0;
+}
+
+/* Compare function for sorting candidate units into list order.  */
+
+static int
+compare_unit_candidates (const void *a, const void *b)
+{
+  const struct lookup_comp_unit *lookup1
+    = *(const struct lookup_comp_unit * const *) a;
+  const struct lookup_comp_unit *lookup2
+    = *(const struct lookup_comp_unit * const *) b;
+
+  if (lookup1->idx < lookup2->idx)
+    return -1;
+  if (lookup1->idx > lookup2->idx)
+    return 1;
+  return 0;
+}
+
+/* For BFD_DWARF_EAGER, read all the remaining compilation units in
+   STASH, decode their line tables and functions, and build a table
+   of their address ranges.  After this, an address lookup only needs
+   to look at the units whose ranges contain the address.  */
+
+static bfd_boolean
+stash_index_comp_units (bfd *abfd, struct dwarf2_debug *stash,
+			unsigned int addr_size,
+			const struct dwarf_debug_section *debug_sections)
+{
+  struct comp_unit *each;
+  struct arange *arange;
+  unsigned int unit_count, range_count, unranged_count, idx;
+  struct lookup_comp_unit *table, *unranged, *entry;
+  bfd_vma high_addr;
+  bfd_size_type amt;
+
+  while (stash->info_ptr < stash->info_ptr_end)
+    {
+      bfd_boolean stop;
+
+      read_next_comp_unit (stash, addr_size, debug_sections, &stop);
+      if (stop)
+	break;
+    }
+
+  /* Decoding the line table may add address ranges to the unit, so
+     do that before building the table.  */
+  unit_count = 0;
+  range_count = 0;
+  unranged_count = 0;
+  for (each = stash->all_comp_units; each; each = each->next_unit)
+    {
+      comp_unit_maybe_decode_line_info (each, stash);
+      unit_count++;
+      if (each->arange.high == 0)
+	unranged_count++;
+      else
+	for (arange = &each->arange; arange; arange = arange->next)
+	  range_count++;
+    }
+
+  if (unit_count == 0)
+    {
+      stash->units_indexed = TRUE;
+      return TRUE;
+    }
+
+  amt = (range_count + unranged_count) * sizeof (struct lookup_comp_unit);
+  table = (struct lookup_comp_unit *) bfd_alloc (abfd, amt);
+  if (table == NULL)
+    return FALSE;
+  amt = unit_count * sizeof (struct lookup_comp_unit *);
+  stash->unit_candidates = (struct lookup_comp_unit **) bfd_alloc (abfd, amt);
+  if (stash->unit_candidates == NULL)
+    return FALSE;
+  unranged = table + range_count;
+
+  entry = table;
+  idx = 0;
+  for (each = stash->all_comp_units; each; each = each->next_unit, idx++)
+    {
+      if (each->arange.high == 0)
+	{
+	  unranged->unit = each;
+	  unranged->low_addr = 0;
+	  unranged->high_addr = 0;
+	  unranged->idx = idx;
+	  unranged++;
+	  continue;
+	}
+      for (arange = &each->arange; arange; arange = arange->next)
+	{
+	  entry->unit = each;
+	  entry->low_addr = arange->low;
+	  entry->high_addr = arange->high;
+	  entry->idx = idx;
+	  entry++;
+	}
+    }
+
+  qsort (table, range_count, sizeof (struct lookup_comp_unit),
+	 compare_lookup_comp_units);
+
+  /* Make HIGH_ADDR the highest address seen so far, so that the
+     array can be binary searched for the first range which might
+     contain a given address.  */
+  high_addr = 0;
+  for (entry = table; entry < table + range_count; entry++)
+    {
+      if (entry->high_addr > high_addr)
+	high_addr = entry->high_addr;
+      else
+	entry->high_addr = high_addr;
+    }
+
+  stash->unit_lookup_table = table;
+  stash->unit_lookup_count = range_count;
+  stash->unranged_units = table + range_count;
+  stash->unranged_unit_count = unranged_count;
+  stash->units_indexed = TRUE;
+  return TRUE;
+}
+
+/* Collect the units in STASH which may contain ADDR into
+   stash->unit_candidates, in the order of the all_comp_units list.
+   Return the number of units.  */
+
+static unsigned int
+stash_find_unit_candidates (struct dwarf2_debug *stash, bfd_vma addr)
+{
+  struct lookup_comp_unit *table = stash->unit_lookup_table;
+  struct lookup_comp_unit **candidates = stash->unit_candidates;
+  unsigned int low, high, mid, first, count, i, j;
+
+  low = 0;
+  high = stash->unit_lookup_count;
+  first = high;
+  while (low < high)
+    {
+      mid = (low + high) / 2;
+      if (addr < table[mid].low_addr)
+	high = mid;
+      else if (addr >= table[mid].high_addr)
+	low = mid + 1;
+      else
+	high = first = mid;
+    }
+
+  count = 0;
+  for (i = 0; i < stash->unranged_unit_count; i++)
+    candidates[count++] = &stash->unranged_units[i];
+  for (; first < stash->unit_lookup_count; first++)
+    {
+      if (addr < table[first].low_addr)
+	break;
+      if (comp_unit_contains_address (table[first].unit, addr))
+	{
+	  /* A unit with several ranges may appear more than once.  */
+	  for (j = 0; j < count; j++)
+	    if (candidates[j]->unit == table[first].unit)
+	      break;
+	  if (j == count)
+	    candidates[count++] = &table[first];
+	}
+    }
+
+  if (count > 1)
+    qsort (candidates, count, sizeof (struct lookup_comp_unit *),
+	   compare_unit_candidates);
+  return count;
+}
+
 /* Find the source code location of SYMBOL.  If SYMBOL is NULL
    then find the nearest source code location corresponding to
    the address SECTION + OFFSET.
@@ -3920,6 +4472,12 @@ _bfd_dwarf2_find_nearest_line (bfd *abfd,
 
   stash->inliner_chain = NULL;
 
+  /* If asked to, read and index all the compilation units now, so
+     that each lookup only has to check the units which contain the
+     address.  */
+  if ((abfd->flags & BFD_DWARF_EAGER) != 0 && !stash->units_indexed)
+    stash_index_comp_units (abfd, stash, addr_size, debug_sections);
+
   /* Check the previously read comp. units first.  */
   if (do_line)
     {
@@ -3963,8 +4521,23 @@ _bfd_dwarf2_find_nearest_line (bfd *abfd,
       struct funcinfo *local_function = NULL;
       unsigned int local_linenumber = 0;
       unsigned int local_discriminator = 0;
+      unsigned int candidate = 0;
+      unsigned int candidate_count = 0;
 
-      for (each = stash->all_comp_units; each; each = each->next_unit)
+      if (stash->units_indexed)
+	{
+	  candidate_count = stash_find_unit_candidates (stash, addr);
+	  each = candidate_count ? stash->unit_candidates[0]->unit : NULL;
+	}
+      else
+	each = stash->all_comp_units;
+
+      for (;
+	   each;
+	   each = (stash->units_indexed
+		   ? (++candidate < candidate_count
+		      ? stash->unit_candidates[candidate]->unit : NULL)
+		   : each->next_unit))
 	{
 	  bfd_vma range = (bfd_vma) -1;
 
@@ -4011,119 +4584,45 @@ _bfd_dwarf2_find_nearest_line (bfd *abfd,
 	}
     }
 
-  /* The DWARF2 spec says that the initial length field, and the
-     offset of the abbreviation table, should both be 4-byte values.
-     However, some compilers do things differently.  */
-  if (addr_size == 0)
-    addr_size = 4;
-  BFD_ASSERT (addr_size == 4 || addr_size == 8);
-
   /* Read each remaining comp. units checking each as they are read.  */
   while (stash->info_ptr < stash->info_ptr_end)
     {
-      bfd_vma length;
-      unsigned int offset_size = addr_size;
-      bfd_byte *info_ptr_unit = stash->info_ptr;
-
-      length = read_4_bytes (stash->bfd_ptr, stash->info_ptr, stash->info_ptr_end);
-      /* A 0xffffff length is the DWARF3 way of indicating
-	 we use 64-bit offsets, instead of 32-bit offsets.  */
-      if (length == 0xffffffff)
-	{
-	  offset_size = 8;
-	  length = read_8_bytes (stash->bfd_ptr, stash->info_ptr + 4, stash->info_ptr_end);
-	  stash->info_ptr += 12;
-	}
-      /* A zero length is the IRIX way of indicating 64-bit offsets,
-	 mostly because the 64-bit length will generally fit in 32
-	 bits, and the endianness helps.  */
-      else if (length == 0)
-	{
-	  offset_size = 8;
-	  length = read_4_bytes (stash->bfd_ptr, stash->info_ptr + 4, stash->info_ptr_end);
-	  stash->info_ptr += 8;
-	}
-      /* In the absence of the hints above, we assume 32-bit DWARF2
-	 offsets even for targets with 64-bit addresses, because:
-	   a) most of the time these targets will not have generated
-	      more than 2Gb of debug info and so will not need 64-bit
-	      offsets,
-	 and
-	   b) if they do use 64-bit offsets but they are not using
-	      the size hints that are tested for above then they are
-	      not conforming to the DWARF3 standard anyway.  */
-      else if (addr_size == 8)
-	{
-	  offset_size = 4;
-	  stash->info_ptr += 4;
-	}
-      else
-	stash->info_ptr += 4;
+      bfd_boolean stop;
 
-      if (length > 0)
+      each = read_next_comp_unit (stash, addr_size, debug_sections, &stop);
+      if (stop)
 	{
-	  bfd_byte * new_ptr;
-
-	  each = parse_comp_unit (stash, length, info_ptr_unit,
-				  offset_size);
-	  if (!each)
-	    /* The dwarf information is damaged, don't trust it any
-	       more.  */
-	    break;
-
-	  new_ptr = stash->info_ptr + length;
-	  /* PR 17512: file: 1500698c.  */
-	  if (new_ptr < stash->info_ptr)
-	    {
-	      /* A corrupt length value - do not trust the info any more.  */
-	      found = FALSE;
-	      break;
-	    }
-	  else
-	    stash->info_ptr = new_ptr;
-
-	  if (stash->all_comp_units)
-	    stash->all_comp_units->prev_unit = each;
-	  else
-	    stash->last_comp_unit = each;
-
-	  each->next_unit = stash->all_comp_units;
-	  stash->all_comp_units = each;
-
-	  /* DW_AT_low_pc and DW_AT_high_pc are optional for
-	     compilation units.  If we don't have them (i.e.,
-	     unit->high == 0), we need to consult the line info table
-	     to see if a compilation unit contains the given
-	     address.  */
-	  if (do_line)
-	    found = (((symbol->flags & BSF_FUNCTION) == 0
-		      || each->arange.high == 0
-		      || comp_unit_contains_address (each, addr))
-		     && comp_unit_find_line (each, symbol, addr,
-					     filename_ptr,
-					     linenumber_ptr,
-					     stash));
-	  else
-	    found = ((each->arange.high == 0
-		      || comp_unit_contains_address (each, addr))
-		     && comp_unit_find_nearest_line (each, addr,
-						     filename_ptr,
-						     &function,
-						     linenumber_ptr,
-						     discriminator_ptr,
-						     stash) != 0);
-
-	  if ((bfd_vma) (stash->info_ptr - stash->sec_info_ptr)
-	      == stash->sec->size)
-	    {
-	      stash->sec = find_debug_info (stash->bfd_ptr, debug_sections,
-					    stash->sec);
-	      stash->sec_info_ptr = stash->info_ptr;
-	    }
-
-	  if (found)
-	    goto done;
+	  found = FALSE;
+	  break;
 	}
+      if (each == NULL)
+	continue;
+
+      /* DW_AT_low_pc and DW_AT_high_pc are optional for
+	 compilation units.  If we don't have them (i.e.,
+	 unit->high == 0), we need to consult the line info table
+	 to see if a compilation unit contains the given
+	 address.  */
+      if (do_line)
+	found = (((symbol->flags & BSF_FUNCTION) == 0
+		  || each->arange.high == 0
+		  || comp_unit_contains_address (each, addr))
+		 && comp_unit_find_line (each, symbol, addr,
+					 filename_ptr,
+					 linenumber_ptr,
+					 stash));
+      else
+	found = ((each->arange.high == 0
+		  || comp_unit_contains_address (each, addr))
+		 && comp_unit_find_nearest_line (each, addr,
+						 filename_ptr,
+						 &function,
+						 linenumber_ptr,
+						 discriminator_ptr,
+						 stash) != 0);
+
+      if (found)
+	goto done;
     }
 
  done:
@@ -101,8 +101,8 @@ _bfd_elf_strtab_init (void)
   if (table == NULL)
     return NULL;
 
-  if (!bfd_hash_table_init (&table->table, elf_strtab_hash_newfunc,
-			    sizeof (struct elf_strtab_hash_entry)))
+  if (!bfd_hash_table_init_open (&table->table, elf_strtab_hash_newfunc,
+				 sizeof (struct elf_strtab_hash_entry)))
     {
       free (table);
       return NULL;
@@ -285,30 +285,6 @@ _bfd_elf_strtab_emit (register bfd *abfd, struct elf_strtab_hash *tab)
   return TRUE;
 }
 
-/* Compare two elf_strtab_hash_entry structures.  Called via qsort.  */
-
-static int
-strrevcmp (const void *a, const void *b)
-{
-  struct elf_strtab_hash_entry *A = *(struct elf_strtab_hash_entry **) a;
-  struct elf_strtab_hash_entry *B = *(struct elf_strtab_hash_entry **) b;
-  unsigned int lenA = A->len;
-  unsigned int lenB = B->len;
-  const unsigned char *s = (const unsigned char *) A->root.string + lenA - 1;
-  const unsigned char *t = (const unsigned char *) B->root.string + lenB - 1;
-  int l = lenA < lenB ? lenA : lenB;
-
-  while (l)
-    {
-      if (*s != *t)
-	return (int) *s - (int) *t;
-      s--;
-      t--;
-      l--;
-    }
-  return lenA - lenB;
-}
-
 static inline int
 is_suffix (const struct elf_strtab_hash_entry *A,
 	   const struct elf_strtab_hash_entry *B)
@@ -328,7 +304,8 @@ is_suffix (const struct elf_strtab_hash_entry *A,
 void
 _bfd_elf_strtab_finalize (struct elf_strtab_hash *tab)
 {
-  struct elf_strtab_hash_entry **array, **a, *e;
+  struct bfd_strrev_key *array, *a;
+  struct elf_strtab_hash_entry *e;
   bfd_size_type size, amt;
 
   /* GCC 2.91.66 (egcs-1.1.2) on i386 miscompiles this function when i is
@@ -338,8 +315,8 @@ _bfd_elf_strtab_finalize (struct elf_strtab_hash *tab)
   size_t i;
 
   /* Sort the strings by suffix and length.  */
-  amt = tab->size * sizeof (struct elf_strtab_hash_entry *);
-  array = (struct elf_strtab_hash_entry **) bfd_malloc (amt);
+  amt = tab->size * sizeof (struct bfd_strrev_key);
+  array = (struct bfd_strrev_key *) bfd_malloc (amt);
   if (array == NULL)
     goto alloc_failure;
 
@@ -348,9 +325,12 @@ _bfd_elf_strtab_finalize (struct elf_strtab_hash *tab)
       e = tab->array[i];
       if (e->refcount)
 	{
-	  *a++ = e;
 	  /* Adjust the length to not include the zero terminator.  */
 	  e->len -= 1;
+	  a->str = (const unsigned char *) e->root.string;
+	  a->len = e->len;
+	  a->entry = e;
+	  a++;
 	}
       else
 	e->len = 0;
@@ -359,7 +339,7 @@ _bfd_elf_strtab_finalize (struct elf_strtab_hash *tab)
   size = a - array;
   if (size != 0)
     {
-      qsort (array, size, sizeof (struct elf_strtab_hash_entry *), strrevcmp);
+      _bfd_strrev_sort (array, size);
 
       /* Loop over the sorted array and merge suffixes.  Start from the
 	 end because we want eg.
@@ -375,11 +355,12 @@ _bfd_elf_strtab_finalize (struct elf_strtab_hash *tab)
 	 s1 _______^
 
 	 ie. we don't want s1 pointing into the old s2.  */
-      e = *--a;
+      e = (struct elf_strtab_hash_entry *) (--a)->entry;
       e->len += 1;
       while (--a >= array)
 	{
-	  struct elf_strtab_hash_entry *cmp = *a;
+	  struct elf_strtab_hash_entry *cmp
+	    = (struct elf_strtab_hash_entry *) a->entry;
 
 	  cmp->len += 1;
 	  if (is_suffix (e, cmp))
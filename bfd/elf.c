@@ -1068,10 +1068,12 @@ _bfd_elf_make_section_from_shdr (bfd *abfd,
       enum { nothing, compress, decompress } action = nothing;
       int compression_header_size;
       bfd_size_type uncompressed_size;
+      unsigned int ch_type;
       bfd_boolean compressed
 	= bfd_is_section_compressed_with_header (abfd, newsect,
 						 &compression_header_size,
-						 &uncompressed_size);
+						 &uncompressed_size,
+						 &ch_type);
 
       if (compressed)
 	{
@@ -1090,7 +1092,9 @@ _bfd_elf_make_section_from_shdr (bfd *abfd,
 	      && uncompressed_size > 0
 	      && (!compressed
 		  || ((compression_header_size > 0)
-		      != ((abfd->flags & BFD_COMPRESS_GABI) != 0))))
+		      != ((abfd->flags & BFD_COMPRESS_GABI) != 0))
+		  || ((ch_type == ELFCOMPRESS_ZSTD)
+		      != ((abfd->flags & BFD_COMPRESS_ZSTD) != 0))))
 	    action = compress;
 	  else
 	    return TRUE;
@@ -3366,6 +3366,10 @@ _bfd_elf_notice_as_needed (bfd *ibfd,
   return (*info->callbacks->notice) (info, NULL, NULL, ibfd, NULL, act, 0);
 }
 
+/* How many symbols apart elf_link_add_object_symbols issues each
+   stage of bfd_hash_prefetch for a symbol's name.  */
+#define ELF_HASH_PREFETCH_DISTANCE 4
+
 /* Add symbols from an ELF object file to the linker hash table.  */
 
 static bfd_boolean
@@ -3386,6 +3390,7 @@ elf_link_add_object_symbols (bfd *abfd, struct bfd_link_info *info)
   Elf_Internal_Sym *isymbuf = NULL;
   Elf_Internal_Sym *isym;
   Elf_Internal_Sym *isymend;
+  unsigned long *name_hash = NULL;
   const struct elf_backend_data *bed;
   bfd_boolean add_needed;
   struct elf_link_hash_table *htab;
@@ -3862,6 +3867,36 @@ error_free_dyn:
 	}
     }
 
+  /* Hash the names of this object's global symbols before adding
+     any of them, so that the loop below can start fetching the parts
+     of the linker hash table that later lookups will touch.  In a
+     large link almost every lookup would otherwise miss the cache on
+     the bucket, on the entry it points to, and on that entry's name.  */
+  if (extsymcount >= 3 * ELF_HASH_PREFETCH_DISTANCE
+      && hdr->sh_link < elf_numsections (abfd)
+      && elf_elfsections (abfd)[hdr->sh_link]->sh_type == SHT_STRTAB)
+    {
+      name_hash = (unsigned long *)
+	bfd_malloc (extsymcount * sizeof (unsigned long));
+      if (name_hash != NULL)
+	for (isym = isymbuf, isymend = isymbuf + extsymcount;
+	     isym < isymend;
+	     isym++)
+	  {
+	    const char *name;
+	    unsigned long hash = 0;
+
+	    /* Leave bad names for the loop below to report.  */
+	    if (ELF_ST_BIND (isym->st_info) != STB_LOCAL
+		&& (isym->st_name
+		    < elf_elfsections (abfd)[hdr->sh_link]->sh_size)
+		&& (name = bfd_elf_string_from_elf_section
+		    (abfd, hdr->sh_link, isym->st_name)) != NULL)
+	      hash = bfd_hash_string_hash (&htab->root.table, name);
+	    name_hash[isym - isymbuf] = hash;
+	  }
+    }
+
   weaks = NULL;
   ever = extversym != NULL ? extversym + extsymoff : NULL;
   for (isym = isymbuf, isymend = isymbuf + extsymcount;
@@ -3886,6 +3921,21 @@ error_free_dyn:
       unsigned int old_alignment;
       bfd *old_bfd;
 
+      if (name_hash != NULL)
+	{
+	  bfd_size_type k = isym - isymbuf;
+	  int stage;
+
+	  for (stage = 0; stage < 3; stage++)
+	    {
+	      bfd_size_type ahead = (3 - stage) * ELF_HASH_PREFETCH_DISTANCE;
+
+	      if (k + ahead < extsymcount)
+		bfd_hash_prefetch (&htab->root.table, name_hash[k + ahead],
+				   stage);
+	    }
+	}
+
       override = FALSE;
 
       flags = BSF_NO_FLAGS;
@@ -4529,6 +4579,12 @@ error_free_dyn:
       isymbuf = NULL;
     }
 
+  if (name_hash != NULL)
+    {
+      free (name_hash);
+      name_hash = NULL;
+    }
+
   if ((elf_dyn_lib_class (abfd) & DYN_AS_NEEDED) != 0)
     {
       unsigned int i;
@@ -4933,6 +4989,8 @@ error_free_dyn:
   if (extversym != NULL)
     free (extversym);
  error_free_sym:
+  if (name_hash != NULL)
+    free (name_hash);
   if (isymbuf != NULL)
     free (isymbuf);
  error_return:
@@ -8297,6 +8355,128 @@ elf_link_sort_cmp2 (const void *A, const void *B)
   return 0;
 }
 
+/* A reloc and its sort keys, for elf_link_radix_sort.  NEXT is the
+   key to sort on after KEY, kept here so that it can be loaded
+   without going back to the reloc.  */
+
+struct elf_link_sort_key
+{
+  bfd_vma key;
+  bfd_vma next;
+  struct elf_link_sort_rela *s;
+};
+
+/* Stably sort the COUNT entries of KEYS by their key fields, with an
+   LSD radix sort taking one byte per pass.  Passes over bytes that are
+   the same in every key are skipped.  TMP has room for COUNT entries.
+   Return whichever of KEYS and TMP holds the result.  */
+
+static struct elf_link_sort_key *
+elf_link_radix_sort (struct elf_link_sort_key *keys,
+		     struct elf_link_sort_key *tmp,
+		     size_t count)
+{
+  size_t hist[sizeof (bfd_vma)][256];
+  unsigned int byte;
+  size_t i;
+
+  memset (hist, 0, sizeof (hist));
+  for (i = 0; i < count; i++)
+    for (byte = 0; byte < sizeof (bfd_vma); byte++)
+      hist[byte][(keys[i].key >> (byte * 8)) & 0xff]++;
+
+  for (byte = 0; byte < sizeof (bfd_vma); byte++)
+    {
+      size_t pos, n;
+      unsigned int b;
+      struct elf_link_sort_key *t;
+
+      if (hist[byte][(keys[0].key >> (byte * 8)) & 0xff] == count)
+	continue;
+
+      for (pos = 0, b = 0; b < 256; b++)
+	{
+	  n = hist[byte][b];
+	  hist[byte][b] = pos;
+	  pos += n;
+	}
+      for (i = 0; i < count; i++)
+	tmp[hist[byte][(keys[i].key >> (byte * 8)) & 0xff]++] = keys[i];
+
+      t = keys;
+      keys = tmp;
+      tmp = t;
+    }
+
+  return keys;
+}
+
+/* Copy the COUNT relocs of size ELT listed in KEYS to BASE, in the
+   order they are listed.  TMP has room for COUNT relocs.  */
+
+static void
+elf_link_sort_permute (bfd_byte *base, bfd_byte *tmp,
+		       const struct elf_link_sort_key *keys,
+		       size_t count, size_t elt)
+{
+  size_t i;
+
+  for (i = 0; i < count; i++)
+    memcpy (tmp + i * elt, keys[i].s, elt);
+  memcpy (base, tmp, count * elt);
+}
+
+/* Sort the COUNT relocs of size ELT at BASE as qsort with
+   elf_link_sort_cmp1 (if !CMP2) or elf_link_sort_cmp2 (if CMP2)
+   would, keeping relocs that compare equal in their original order.
+   Each field of the comparison is sorted on in turn, least
+   significant first.  KEYS has room for twice COUNT entries, and TMP
+   for COUNT relocs.  */
+
+static void
+elf_link_radix_sort_relocs (bfd_byte *base, bfd_byte *tmp,
+			    struct elf_link_sort_key *keys,
+			    size_t count, size_t elt, bfd_boolean cmp2)
+{
+  struct elf_link_sort_key *k;
+  size_t i;
+
+  if (count < 2)
+    return;
+
+  for (i = 0; i < count; i++)
+    {
+      struct elf_link_sort_rela *s;
+
+      s = (struct elf_link_sort_rela *) (base + i * elt);
+      keys[i].s = s;
+      keys[i].key = s->rela->r_offset;
+      if (cmp2)
+	keys[i].next = s->u.offset;
+      else
+	/* The bits cleared by the symbol mask include bit 0, so the
+	   symbol can be shifted down to make room for the relative
+	   flag above it.  */
+	keys[i].next = (((bfd_vma) (s->type != reloc_class_relative)
+			 << (sizeof (bfd_vma) * 8 - 1))
+			| ((s->rela->r_info & s->u.sym_mask) >> 1));
+    }
+
+  k = elf_link_radix_sort (keys, keys + count, count);
+  for (i = 0; i < count; i++)
+    k[i].key = k[i].next;
+  k = elf_link_radix_sort (k, k == keys ? keys + count : keys, count);
+
+  if (cmp2)
+    {
+      for (i = 0; i < count; i++)
+	k[i].key = k[i].s->type;
+      k = elf_link_radix_sort (k, k == keys ? keys + count : keys, count);
+    }
+
+  elf_link_sort_permute (base, tmp, k, count, elt);
+}
+
 static size_t
 elf_link_sort_relocs (bfd *abfd, struct bfd_link_info *info, asection **psec)
 {
@@ -8306,6 +8486,8 @@ elf_link_sort_relocs (bfd *abfd, struct bfd_link_info *info, asection **psec)
   bfd_size_type count, size;
   size_t i, ret, sort_elt, ext_size;
   bfd_byte *sort, *s_non_relative, *p;
+  bfd_byte *sort_tmp;
+  struct elf_link_sort_key *keys;
   struct elf_link_sort_rela *sq;
   const struct elf_backend_data *bed = get_elf_backend_data (abfd);
   int i2e = bed->s->int_rels_per_ext_rel;
@@ -8522,7 +8704,24 @@ elf_link_sort_relocs (bfd *abfd, struct bfd_link_info *info, asection **psec)
 	  }
       }
 
-  qsort (sort, count, sort_elt, elf_link_sort_cmp1);
+  /* Radix sort the relocs if there is memory for it, since there may
+     be millions of them.  */
+  keys = (struct elf_link_sort_key *) bfd_malloc (2 * count * sizeof (*keys));
+  sort_tmp = NULL;
+  if (keys != NULL)
+    {
+      sort_tmp = (bfd_byte *) bfd_malloc (sort_elt * count);
+      if (sort_tmp == NULL)
+	{
+	  free (keys);
+	  keys = NULL;
+	}
+    }
+
+  if (keys != NULL)
+    elf_link_radix_sort_relocs (sort, sort_tmp, keys, count, sort_elt, FALSE);
+  else
+    qsort (sort, count, sort_elt, elf_link_sort_cmp1);
 
   for (i = 0, p = sort; i < count; i++, p += sort_elt)
     {
@@ -8542,7 +8741,15 @@ elf_link_sort_relocs (bfd *abfd, struct bfd_link_info *info, asection **psec)
       sp->u.offset = sq->rela->r_offset;
     }
 
-  qsort (s_non_relative, count - ret, sort_elt, elf_link_sort_cmp2);
+  if (keys != NULL)
+    {
+      elf_link_radix_sort_relocs (s_non_relative, sort_tmp, keys,
+				  count - ret, sort_elt, TRUE);
+      free (keys);
+      free (sort_tmp);
+    }
+  else
+    qsort (s_non_relative, count - ret, sort_elt, elf_link_sort_cmp2);
 
   for (lo = dynamic_relocs->map_head.link_order; lo != NULL; lo = lo->next)
     if (lo->type == bfd_indirect_link_order)
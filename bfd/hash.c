@@ -71,6 +71,18 @@ SUBSECTION
 	<<bfd_hash_table_init>> returns <<FALSE>> if some sort of
 	error occurs.
 
+@findex bfd_hash_table_init_open
+@findex bfd_hash_table_init_open_n
+	A table created with <<bfd_hash_table_init_open>> or
+	<<bfd_hash_table_init_open_n>>, which take the same arguments
+	as <<bfd_hash_table_init>> and <<bfd_hash_table_init_n>>, uses
+	open addressing rather than chaining entries into buckets.
+	Looking up a string then only examines a contiguous array of
+	hash codes and entry pointers, which is faster for large
+	tables.  The entries are visited in a different order by
+	<<bfd_hash_traverse>>, and the <<table>> field of such a table
+	is <<NULL>>, so it must not be walked directly.
+
 @findex bfd_hash_newfunc
 	The function <<bfd_hash_table_init>> take as an argument a
 	function to use to create new entries.  For a basic hash
@@ -362,6 +374,71 @@ higher_prime_number (unsigned long n)
 
 static unsigned long bfd_default_hash_table_size = DEFAULT_SIZE;
 
+/* The smallest number of slots in an open addressed hash table.  */
+#define MIN_OPEN_SIZE 16
+
+/* Return the first slot to probe for HASH in an open addressed table
+   of SIZE slots, where SIZE is a power of two.  */
+
+static inline unsigned int
+bfd_hash_slot_index (unsigned long hash, unsigned int size)
+{
+  return (unsigned int) hash & (size - 1);
+}
+
+/* Allocate SIZE empty slots for TABLE.  */
+
+static struct bfd_hash_slot *
+bfd_hash_alloc_slots (struct bfd_hash_table *table, unsigned int size)
+{
+  unsigned long alloc;
+  struct bfd_hash_slot *slots;
+
+  alloc = size;
+  alloc *= sizeof (struct bfd_hash_slot);
+  if (alloc / sizeof (struct bfd_hash_slot) != size)
+    return NULL;
+
+  slots = (struct bfd_hash_slot *)
+    objalloc_alloc ((struct objalloc *) table->memory, alloc);
+  if (slots != NULL)
+    memset (slots, 0, alloc);
+  return slots;
+}
+
+/* Put ENTRY in the first empty slot of its probe sequence in SLOTS.  */
+
+static void
+bfd_hash_place (struct bfd_hash_slot *slots, unsigned int size,
+		struct bfd_hash_entry *entry)
+{
+  unsigned int _index;
+
+  _index = bfd_hash_slot_index (entry->hash, size);
+  while (slots[_index].entry != NULL)
+    _index = (_index + 1) & (size - 1);
+  slots[_index].hash = entry->hash;
+  slots[_index].entry = entry;
+}
+
+/* Return the slot holding ENTRY in an open addressed TABLE.  */
+
+static unsigned int
+bfd_hash_find_slot (struct bfd_hash_table *table,
+		    struct bfd_hash_entry *entry)
+{
+  unsigned int _index;
+
+  _index = bfd_hash_slot_index (entry->hash, table->size);
+  while (table->slots[_index].entry != entry)
+    {
+      if (table->slots[_index].entry == NULL)
+	abort ();
+      _index = (_index + 1) & (table->size - 1);
+    }
+  return _index;
+}
+
 /* Create a new hash table, given a number of entries.  */
 
 bfd_boolean
@@ -397,6 +474,7 @@ bfd_hash_table_init_n (struct bfd_hash_table *table,
       return FALSE;
     }
   memset ((void *) table->table, 0, alloc);
+  table->slots = NULL;
   table->size = size;
   table->entsize = entsize;
   table->count = 0;
@@ -405,6 +483,66 @@ bfd_hash_table_init_n (struct bfd_hash_table *table,
   return TRUE;
 }
 
+/* Create a new open addressed hash table, given a number of entries.  */
+
+bfd_boolean
+bfd_hash_table_init_open_n (struct bfd_hash_table *table,
+			    struct bfd_hash_entry *(*newfunc) (struct bfd_hash_entry *,
+							       struct bfd_hash_table *,
+							       const char *),
+			    unsigned int entsize,
+			    unsigned int size)
+{
+  unsigned int nslots;
+
+  /* Round up to a power of two.  */
+  nslots = MIN_OPEN_SIZE;
+  while (nslots < size)
+    {
+      nslots <<= 1;
+      if (nslots == 0)
+	{
+	  bfd_set_error (bfd_error_no_memory);
+	  return FALSE;
+	}
+    }
+
+  table->memory = (void *) objalloc_create ();
+  if (table->memory == NULL)
+    {
+      bfd_set_error (bfd_error_no_memory);
+      return FALSE;
+    }
+  table->table = NULL;
+  table->slots = bfd_hash_alloc_slots (table, nslots);
+  if (table->slots == NULL)
+    {
+      bfd_hash_table_free (table);
+      bfd_set_error (bfd_error_no_memory);
+      return FALSE;
+    }
+  table->size = nslots;
+  table->entsize = entsize;
+  table->count = 0;
+  table->frozen = 0;
+  table->newfunc = newfunc;
+  return TRUE;
+}
+
+/* Create a new open addressed hash table with the default number of
+   entries.  */
+
+bfd_boolean
+bfd_hash_table_init_open (struct bfd_hash_table *table,
+			  struct bfd_hash_entry *(*newfunc) (struct bfd_hash_entry *,
+							     struct bfd_hash_table *,
+							     const char *),
+			  unsigned int entsize)
+{
+  return bfd_hash_table_init_open_n (table, newfunc, entsize,
+				     bfd_default_hash_table_size);
+}
+
 /* Create a new hash table with the default number of entries.  */
 
 bfd_boolean
@@ -451,6 +589,66 @@ bfd_hash_hash (const char *string, unsigned int *lenp)
   return hash;
 }
 
+/* Return the MurmurHash3 hash of the LEN bytes at DATA.  This reads
+   four bytes at a time and is several times faster than
+   bfd_hash_hash.  */
+
+unsigned long
+_bfd_hash_bytes (const void *data, unsigned int len)
+{
+  const unsigned char *s;
+  unsigned int n;
+  unsigned int hash, k;
+
+  s = (const unsigned char *) data;
+  hash = 0;
+  for (n = len; n >= 4; n -= 4, s += 4)
+    {
+      memcpy (&k, s, 4);
+      k *= 0xcc9e2d51;
+      k = (k << 15) | (k >> 17);
+      k *= 0x1b873593;
+      hash ^= k;
+      hash = (hash << 13) | (hash >> 19);
+      hash = hash * 5 + 0xe6546b64;
+    }
+  if (n != 0)
+    {
+      k = s[0];
+      if (n > 1)
+	k |= s[1] << 8;
+      if (n > 2)
+	k |= s[2] << 16;
+      k *= 0xcc9e2d51;
+      k = (k << 15) | (k >> 17);
+      k *= 0x1b873593;
+      hash ^= k;
+    }
+  hash ^= len;
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6b;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+/* The string hash used by open addressed tables.  Chained tables keep
+   bfd_hash_hash, since the order in which bfd_hash_traverse visits
+   their entries, and so the order of symbols in linker output,
+   depends on it.  */
+
+static inline unsigned long
+bfd_hash_hash_open (const char *string, unsigned int *lenp)
+{
+  unsigned int len;
+
+  len = strlen (string);
+  if (lenp != NULL)
+    *lenp = len;
+  return _bfd_hash_bytes (string, len);
+}
+
 /* Look up a string in a hash table.  */
 
 struct bfd_hash_entry *
@@ -464,15 +662,34 @@ bfd_hash_lookup (struct bfd_hash_table *table,
   unsigned int len;
   unsigned int _index;
 
-  hash = bfd_hash_hash (string, &len);
-  _index = hash % table->size;
-  for (hashp = table->table[_index];
-       hashp != NULL;
-       hashp = hashp->next)
+  if (table->slots != NULL)
     {
-      if (hashp->hash == hash
-	  && strcmp (hashp->string, string) == 0)
-	return hashp;
+      struct bfd_hash_slot *slot;
+
+      hash = bfd_hash_hash_open (string, &len);
+      _index = bfd_hash_slot_index (hash, table->size);
+      for (slot = &table->slots[_index];
+	   slot->entry != NULL;
+	   _index = (_index + 1) & (table->size - 1),
+	     slot = &table->slots[_index])
+	{
+	  if (slot->hash == hash
+	      && strcmp (slot->entry->string, string) == 0)
+	    return slot->entry;
+	}
+    }
+  else
+    {
+      hash = bfd_hash_hash (string, &len);
+      _index = hash % table->size;
+      for (hashp = table->table[_index];
+	   hashp != NULL;
+	   hashp = hashp->next)
+	{
+	  if (hashp->hash == hash
+	      && strcmp (hashp->string, string) == 0)
+	    return hashp;
+	}
     }
 
   if (! create)
@@ -496,7 +713,130 @@ bfd_hash_lookup (struct bfd_hash_table *table,
   return bfd_hash_insert (table, string, hash);
 }
 
-/* Insert an entry in a hash table.  */
+/* Return the hash code that bfd_hash_lookup computes for STRING in
+   TABLE.  */
+
+unsigned long
+bfd_hash_string_hash (struct bfd_hash_table *table, const char *string)
+{
+  if (table->slots != NULL)
+    return bfd_hash_hash_open (string, NULL);
+  return bfd_hash_hash (string, NULL);
+}
+
+/* Start fetching into the cache the memory that a lookup of a string
+   with hash code HASH in TABLE examines.  Each STAGE reads what the
+   previous one fetched: stage 0 fetches the bucket or slot, stage 1
+   the entry found there, and stage 2 that entry's string.  Callers
+   should issue the stages for a string some time apart, to avoid
+   stalling on memory here rather than in the lookup.  */
+
+void
+bfd_hash_prefetch (struct bfd_hash_table *table, unsigned long hash,
+		   int stage)
+{
+#if GCC_VERSION >= 3001
+  struct bfd_hash_entry *hashp;
+
+  if (table->slots != NULL)
+    {
+      struct bfd_hash_slot *slot;
+
+      slot = &table->slots[bfd_hash_slot_index (hash, table->size)];
+      if (stage == 0)
+	{
+	  __builtin_prefetch (slot);
+	  return;
+	}
+      hashp = slot->entry;
+    }
+  else
+    {
+      struct bfd_hash_entry **bucket;
+
+      bucket = &table->table[hash % table->size];
+      if (stage == 0)
+	{
+	  __builtin_prefetch (bucket);
+	  return;
+	}
+      hashp = *bucket;
+    }
+
+  if (hashp == NULL)
+    return;
+  if (stage == 1)
+    __builtin_prefetch (hashp);
+  else
+    __builtin_prefetch (hashp->string);
+#else
+  (void) table;
+  (void) hash;
+  (void) stage;
+#endif
+}
+
+/* Double the size of an open addressed hash table.  If this is not
+   possible, freeze the table.  */
+
+static void
+bfd_hash_grow_open (struct bfd_hash_table *table)
+{
+  unsigned int newsize = table->size * 2;
+  struct bfd_hash_slot *newslots;
+  unsigned int i;
+
+  newslots = NULL;
+  if (newsize > table->size)
+    newslots = bfd_hash_alloc_slots (table, newsize);
+  if (newslots == NULL)
+    {
+      table->frozen = 1;
+      return;
+    }
+
+  for (i = 0; i < table->size; i++)
+    if (table->slots[i].entry != NULL)
+      bfd_hash_place (newslots, newsize, table->slots[i].entry);
+  table->slots = newslots;
+  table->size = newsize;
+}
+
+/* Insert an entry in an open addressed hash table.  */
+
+static struct bfd_hash_entry *
+bfd_hash_insert_open (struct bfd_hash_table *table,
+		      const char *string,
+		      unsigned long hash)
+{
+  struct bfd_hash_entry *hashp;
+
+  /* Keep the table no more than two thirds full, so that probe
+     sequences stay short.  */
+  if (!table->frozen && table->count >= table->size - table->size / 3)
+    bfd_hash_grow_open (table);
+
+  /* There must always be an empty slot, to end unsuccessful
+     lookups.  */
+  if (table->count >= table->size - 1)
+    {
+      bfd_set_error (bfd_error_no_memory);
+      return NULL;
+    }
+
+  hashp = (*table->newfunc) (NULL, table, string);
+  if (hashp == NULL)
+    return NULL;
+  hashp->next = NULL;
+  hashp->string = string;
+  hashp->hash = hash;
+  bfd_hash_place (table->slots, table->size, hashp);
+  table->count++;
+  return hashp;
+}
+
+/* Insert an entry in a hash table.  HASH must be the hash code that
+   bfd_hash_lookup computes for STRING in TABLE.  */
 
 struct bfd_hash_entry *
 bfd_hash_insert (struct bfd_hash_table *table,
@@ -506,6 +846,9 @@ bfd_hash_insert (struct bfd_hash_table *table,
   struct bfd_hash_entry *hashp;
   unsigned int _index;
 
+  if (table->slots != NULL)
+    return bfd_hash_insert_open (table, string, hash);
+
   hashp = (*table->newfunc) (NULL, table, string);
   if (hashp == NULL)
     return NULL;
@@ -571,6 +914,34 @@ bfd_hash_rename (struct bfd_hash_table *table,
   unsigned int _index;
   struct bfd_hash_entry **pph;
 
+  if (table->slots != NULL)
+    {
+      unsigned int mask = table->size - 1;
+      unsigned int next, home;
+
+      /* Remove the entry, moving back any later entries in the same
+	 run of slots which would no longer be found.  */
+      _index = bfd_hash_find_slot (table, ent);
+      for (next = (_index + 1) & mask;
+	   table->slots[next].entry != NULL;
+	   next = (next + 1) & mask)
+	{
+	  home = bfd_hash_slot_index (table->slots[next].hash, table->size);
+	  if (_index <= next
+	      ? _index < home && home <= next
+	      : _index < home || home <= next)
+	    continue;
+	  table->slots[_index] = table->slots[next];
+	  _index = next;
+	}
+      table->slots[_index].entry = NULL;
+
+      ent->string = string;
+      ent->hash = bfd_hash_hash_open (string, NULL);
+      bfd_hash_place (table->slots, table->size, ent);
+      return;
+    }
+
   _index = ent->hash % table->size;
   for (pph = &table->table[_index]; *pph != NULL; pph = &(*pph)->next)
     if (*pph == ent)
@@ -596,6 +967,13 @@ bfd_hash_replace (struct bfd_hash_table *table,
   unsigned int _index;
   struct bfd_hash_entry **pph;
 
+  if (table->slots != NULL)
+    {
+      _index = bfd_hash_find_slot (table, old);
+      table->slots[_index].entry = nw;
+      return;
+    }
+
   _index = old->hash % table->size;
   for (pph = &table->table[_index];
        (*pph) != NULL;
@@ -648,14 +1026,22 @@ bfd_hash_traverse (struct bfd_hash_table *table,
   unsigned int i;
 
   table->frozen = 1;
-  for (i = 0; i < table->size; i++)
+  if (table->slots != NULL)
     {
-      struct bfd_hash_entry *p;
-
-      for (p = table->table[i]; p != NULL; p = p->next)
-	if (! (*func) (p, info))
+      for (i = 0; i < table->size; i++)
+	if (table->slots[i].entry != NULL
+	    && ! (*func) (table->slots[i].entry, info))
 	  goto out;
     }
+  else
+    for (i = 0; i < table->size; i++)
+      {
+	struct bfd_hash_entry *p;
+
+	for (p = table->table[i]; p != NULL; p = p->next)
+	  if (! (*func) (p, info))
+	    goto out;
+      }
  out:
   table->frozen = 0;
 }
@@ -767,8 +1153,8 @@ _bfd_stringtab_init (void)
   if (table == NULL)
     return NULL;
 
-  if (!bfd_hash_table_init (&table->table, strtab_hash_newfunc,
-			    sizeof (struct strtab_hash_entry)))
+  if (!bfd_hash_table_init_open (&table->table, strtab_hash_newfunc,
+				 sizeof (struct strtab_hash_entry)))
     {
       free (table);
       return NULL;
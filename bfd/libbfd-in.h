@@ -568,6 +568,20 @@ extern bfd_boolean _bfd_dwarf2_slurp_debug_info
 extern void _bfd_dwarf2_cleanup_debug_info
   (bfd *, void **);
 
+/* A slot in an open addressed hash table.  ENTRY is NULL for an empty
+   slot.  HASH is a copy of ENTRY->hash, so that probing does not need
+   to look at the entries themselves.  */
+
+struct bfd_hash_slot
+{
+  unsigned long hash;
+  struct bfd_hash_entry *entry;
+};
+
+/* Hash a block of memory as open addressed hash tables do.  */
+extern unsigned long _bfd_hash_bytes
+  (const void *, unsigned int);
+
 /* Create a new section entry.  */
 extern struct bfd_hash_entry *bfd_section_hash_newfunc
   (struct bfd_hash_entry *, struct bfd_hash_table *, const char *);
@@ -712,6 +726,21 @@ extern bfd_vma _bfd_merged_section_offset
 
 extern void _bfd_merge_sections_free (void *);
 
+/* A string to be sorted by _bfd_strrev_sort, with the hash table
+   entry it came from.  */
+
+struct bfd_strrev_key
+{
+  const unsigned char *str;
+  unsigned int len;
+  void *entry;
+};
+
+/* Sort strings by comparing characters from the end.  */
+
+extern void _bfd_strrev_sort
+  (struct bfd_strrev_key *, size_t);
+
 /* Create a string table.  */
 extern struct bfd_strtab_hash *_bfd_stringtab_init
   (void);
@@ -138,67 +138,45 @@ sec_merge_hash_lookup (struct sec_merge_hash *table, const char *string,
 {
   const unsigned char *s;
   unsigned long hash;
-  unsigned int c;
   struct sec_merge_hash_entry *hashp;
   unsigned int len, i;
-  unsigned int _index;
+  unsigned int _index, mask;
 
-  hash = 0;
-  len = 0;
   s = (const unsigned char *) string;
   if (table->strings)
     {
       if (table->entsize == 1)
-	{
-	  while ((c = *s++) != '\0')
-	    {
-	      hash += c + (c << 17);
-	      hash ^= hash >> 2;
-	      ++len;
-	    }
-	  hash += len + (len << 17);
-	}
+	len = strlen (string);
       else
 	{
-	  for (;;)
+	  for (len = 0; ; len += table->entsize)
 	    {
 	      for (i = 0; i < table->entsize; ++i)
-		if (s[i] != '\0')
+		if (s[len + i] != '\0')
 		  break;
 	      if (i == table->entsize)
 		break;
-	      for (i = 0; i < table->entsize; ++i)
-		{
-		  c = *s++;
-		  hash += c + (c << 17);
-		  hash ^= hash >> 2;
-		}
-	      ++len;
 	    }
-	  hash += len + (len << 17);
-	  len *= table->entsize;
 	}
-      hash ^= hash >> 2;
+      hash = _bfd_hash_bytes (string, len);
       len += table->entsize;
     }
   else
     {
-      for (i = 0; i < table->entsize; ++i)
-	{
-	  c = *s++;
-	  hash += c + (c << 17);
-	  hash ^= hash >> 2;
-	}
       len = table->entsize;
+      hash = _bfd_hash_bytes (string, len);
     }
 
-  _index = hash % table->table.size;
-  for (hashp = (struct sec_merge_hash_entry *) table->table.table[_index];
-       hashp != NULL;
-       hashp = (struct sec_merge_hash_entry *) hashp->root.next)
+  mask = table->table.size - 1;
+  for (_index = hash & mask;
+       table->table.slots[_index].entry != NULL;
+       _index = (_index + 1) & mask)
     {
-      if (hashp->root.hash == hash
-	  && len == hashp->len
+      if (table->table.slots[_index].hash != hash)
+	continue;
+
+      hashp = (struct sec_merge_hash_entry *) table->table.slots[_index].entry;
+      if (len == hashp->len
 	  && memcmp (hashp->root.string, string, len) == 0)
 	{
 	  /* If the string we found does not have at least the required
@@ -240,8 +218,9 @@ sec_merge_init (unsigned int entsize, bfd_boolean strings)
   if (table == NULL)
     return NULL;
 
-  if (! bfd_hash_table_init_n (&table->table, sec_merge_hash_newfunc,
-			       sizeof (struct sec_merge_hash_entry), 16699))
+  if (! bfd_hash_table_init_open_n (&table->table, sec_merge_hash_newfunc,
+				    sizeof (struct sec_merge_hash_entry),
+				    16384))
     {
       free (table);
       return NULL;
@@ -543,55 +522,141 @@ error_return:
   return FALSE;
 }
 
+/* Compare the lengths of the tails of two strings beyond their last
+   aligned boundary.  All the strings have the same alignment, which is
+   larger than the entity size.  Strings are only merged with others
+   whose tails have the same length.  */
+
 static int
-strrevcmp (const void *a, const void *b)
+tail_align_cmp (const void *a, const void *b)
+{
+  const struct bfd_strrev_key *A = (const struct bfd_strrev_key *) a;
+  const struct bfd_strrev_key *B = (const struct bfd_strrev_key *) b;
+  unsigned int alignment
+    = ((struct sec_merge_hash_entry *) A->entry)->alignment;
+  int tailA = A->len & (alignment - 1);
+  int tailB = B->len & (alignment - 1);
+
+  return tailA - tailB;
+}
+
+/* Return the character DEPTH characters from the end of the string of
+   K, or -1 if the string is shorter than that.  */
+
+static inline int
+strrev_char (const struct bfd_strrev_key *k, unsigned int depth)
+{
+  if (depth >= k->len)
+    return -1;
+  return k->str[k->len - 1 - depth];
+}
+
+static inline void
+strrev_swap (struct bfd_strrev_key *a, size_t i, size_t j)
+{
+  struct bfd_strrev_key t = a[i];
+
+  a[i] = a[j];
+  a[j] = t;
+}
+
+/* Return TRUE if key A sorts after key B, when their last DEPTH
+   characters are known to be equal.  */
+
+static inline bfd_boolean
+strrev_after (const struct bfd_strrev_key *a,
+	      const struct bfd_strrev_key *b, unsigned int depth)
 {
-  struct sec_merge_hash_entry *A = *(struct sec_merge_hash_entry **) a;
-  struct sec_merge_hash_entry *B = *(struct sec_merge_hash_entry **) b;
-  unsigned int lenA = A->len;
-  unsigned int lenB = B->len;
-  const unsigned char *s = (const unsigned char *) A->root.string + lenA - 1;
-  const unsigned char *t = (const unsigned char *) B->root.string + lenB - 1;
-  int l = lenA < lenB ? lenA : lenB;
-
-  while (l)
+  unsigned int l = a->len < b->len ? a->len : b->len;
+
+  for (; depth < l; depth++)
     {
-      if (*s != *t)
-	return (int) *s - (int) *t;
-      s--;
-      t--;
-      l--;
+      int c = a->str[a->len - 1 - depth];
+      int d = b->str[b->len - 1 - depth];
+
+      if (c != d)
+	return c > d;
     }
-  return lenA - lenB;
+  return a->len > b->len;
 }
 
-/* Like strrevcmp, but for the case where all strings have the same
-   alignment > entsize.  */
+/* Sort the N keys of ARRAY when their last DEPTH characters are known
+   to be equal.  This is a multikey quicksort, which looks at each
+   character of a shared suffix once per partition rather than once
+   per comparison.  */
 
-static int
-strrevcmp_align (const void *a, const void *b)
+static void
+strrev_sort (struct bfd_strrev_key *array, size_t n, unsigned int depth)
 {
-  struct sec_merge_hash_entry *A = *(struct sec_merge_hash_entry **) a;
-  struct sec_merge_hash_entry *B = *(struct sec_merge_hash_entry **) b;
-  unsigned int lenA = A->len;
-  unsigned int lenB = B->len;
-  const unsigned char *s = (const unsigned char *) A->root.string + lenA - 1;
-  const unsigned char *t = (const unsigned char *) B->root.string + lenB - 1;
-  int l = lenA < lenB ? lenA : lenB;
-  int tail_align = (lenA & (A->alignment - 1)) - (lenB & (A->alignment - 1));
-
-  if (tail_align != 0)
-    return tail_align;
-
-  while (l)
+  while (n > 1)
     {
-      if (*s != *t)
-	return (int) *s - (int) *t;
-      s--;
-      t--;
-      l--;
+      size_t lt, gt, i;
+      int pivot, a, b, c;
+
+      if (n < 8)
+	{
+	  for (i = 1; i < n; i++)
+	    {
+	      size_t j;
+
+	      for (j = i;
+		   j > 0 && strrev_after (&array[j - 1], &array[j], depth);
+		   j--)
+		strrev_swap (array, j - 1, j);
+	    }
+	  return;
+	}
+
+      /* Median of three characters as the pivot.  */
+      a = strrev_char (&array[0], depth);
+      b = strrev_char (&array[n / 2], depth);
+      c = strrev_char (&array[n - 1], depth);
+      if (a > b)
+	{
+	  int t = a;
+	  a = b;
+	  b = t;
+	}
+      pivot = c < a ? a : c > b ? b : c;
+
+      /* Partition into keys whose character is less than, equal to
+	 and greater than the pivot.  */
+      lt = 0;
+      i = 0;
+      gt = n;
+      while (i < gt)
+	{
+	  c = strrev_char (&array[i], depth);
+	  if (c < pivot)
+	    strrev_swap (array, lt++, i++);
+	  else if (c > pivot)
+	    strrev_swap (array, i, --gt);
+	  else
+	    i++;
+	}
+
+      strrev_sort (array, lt, depth);
+      strrev_sort (array + gt, n - gt, depth);
+
+      /* Strings that end here are all the same string.  */
+      if (pivot < 0)
+	return;
+      array += lt;
+      n = gt - lt;
+      depth++;
     }
-  return lenA - lenB;
+}
+
+/* Sort the N strings of ARRAY by comparing characters from the end,
+   so that a string comes before any longer string it is a suffix of
+   and strings sharing a suffix are adjacent.  The strings are
+   distinct, so the result does not depend on the sort being
+   stable.  */
+
+void
+_bfd_strrev_sort (struct bfd_strrev_key *array, size_t n)
+{
+  strrev_sort (array, n, 0);
 }
 
 static inline int
@@ -612,23 +677,27 @@ is_suffix (const struct sec_merge_hash_entry *A,
 static void
 merge_strings (struct sec_merge_info *sinfo)
 {
-  struct sec_merge_hash_entry **array, **a, *e;
+  struct bfd_strrev_key *array, *a;
+  struct sec_merge_hash_entry **pe, *e;
   struct sec_merge_sec_info *secinfo;
   bfd_size_type size, amt;
   unsigned int alignment = 0;
 
   /* Now sort the strings */
-  amt = sinfo->htab->size * sizeof (struct sec_merge_hash_entry *);
-  array = (struct sec_merge_hash_entry **) bfd_malloc (amt);
+  amt = sinfo->htab->size * sizeof (struct bfd_strrev_key);
+  array = (struct bfd_strrev_key *) bfd_malloc (amt);
   if (array == NULL)
     goto alloc_failure;
 
   for (e = sinfo->htab->first, a = array; e; e = e->next)
     if (e->alignment)
       {
-	*a++ = e;
 	/* Adjust the length to not include the zero terminator.  */
 	e->len -= sinfo->htab->entsize;
+	a->str = (const unsigned char *) e->root.string;
+	a->len = e->len;
+	a->entry = e;
+	a++;
 	if (alignment != e->alignment)
 	  {
 	    if (alignment == 0)
@@ -641,17 +710,34 @@ merge_strings (struct sec_merge_info *sinfo)
   sinfo->htab->size = a - array;
   if (sinfo->htab->size != 0)
     {
-      qsort (array, (size_t) sinfo->htab->size,
-	     sizeof (struct sec_merge_hash_entry *),
-	     (alignment != (unsigned) -1 && alignment > sinfo->htab->entsize
-	      ? strrevcmp_align : strrevcmp));
+      size_t n = sinfo->htab->size;
+
+      if (alignment != (unsigned) -1 && alignment > sinfo->htab->entsize)
+	{
+	  size_t start, end;
+
+	  /* Group the strings by the length of their unaligned tail,
+	     then sort each group by its reversed strings.  */
+	  qsort (array, n, sizeof (struct bfd_strrev_key), tail_align_cmp);
+	  for (start = 0; start < n; start = end)
+	    {
+	      for (end = start + 1;
+		   end < n && tail_align_cmp (&array[start], &array[end]) == 0;
+		   end++)
+		;
+	      _bfd_strrev_sort (array + start, end - start);
+	    }
+	}
+      else
+	_bfd_strrev_sort (array, n);
 
       /* Loop over the sorted array and merge suffixes */
-      e = *--a;
+      e = (struct sec_merge_hash_entry *) (--a)->entry;
       e->len += sinfo->htab->entsize;
       while (--a >= array)
 	{
-	  struct sec_merge_hash_entry *cmp = *a;
+	  struct sec_merge_hash_entry *cmp
+	    = (struct sec_merge_hash_entry *) a->entry;
 
 	  cmp->len += sinfo->htab->entsize;
 	  if (e->alignment >= cmp->alignment
@@ -701,12 +787,12 @@ alloc_failure:
 
   /* And now adjust the rest, removing them from the chain (but not hashtable)
      at the same time.  */
-  for (a = &sinfo->htab->first, e = *a; e; e = e->next)
+  for (pe = &sinfo->htab->first, e = *pe; e; e = e->next)
     if (e->alignment)
-      a = &e->next;
+      pe = &e->next;
     else
       {
-	*a = e->next;
+	*pe = e->next;
 	if (e->len)
 	  {
 	    e->secinfo = e->u.suffix->secinfo;
@@ -34,9 +34,13 @@
 #include "bfd.h"
 #include "getopt.h"
 #include "libiberty.h"
+#include "hashtab.h"
 #include "demangle.h"
 #include "bucomm.h"
 #include "elf-bfd.h"
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
 
 static bfd_boolean unwind_inlines;	/* -i, unwind inlined functions. */
 static bfd_boolean with_addresses;	/* -a, show addresses.  */
@@ -44,19 +48,30 @@ static bfd_boolean with_functions;	/* -f, show function names.  */
 static bfd_boolean do_demangle;		/* -C, demangle names.  */
 static bfd_boolean pretty_print;	/* -p, print on one line.  */
 static bfd_boolean base_names;		/* -s, strip directory names.  */
+static bfd_boolean batch_mode;		/* --batch, read all then translate.  */
+static char *index_dir;			/* --index-dir, keep address indexes.  */
 
 static int naddr;		/* Number of addresses to process.  */
 static char **addr;		/* Hex addresses to process.  */
 
 static asymbol **syms;		/* Symbol table.  */
+static bfd_boolean syms_read;	/* TRUE once slurp_symtab has been called.  */
+
+enum long_only_options
+{
+  OPTION_BATCH = 150,
+  OPTION_INDEX_DIR
+};
 
 static struct option long_options[] =
 {
   {"addresses", no_argument, NULL, 'a'},
   {"basenames", no_argument, NULL, 's'},
+  {"batch", no_argument, NULL, OPTION_BATCH},
   {"demangle", optional_argument, NULL, 'C'},
   {"exe", required_argument, NULL, 'e'},
   {"functions", no_argument, NULL, 'f'},
+  {"index-dir", required_argument, NULL, OPTION_INDEX_DIR},
   {"inlines", no_argument, NULL, 'i'},
   {"pretty-print", no_argument, NULL, 'p'},
   {"section", required_argument, NULL, 'j'},
@@ -71,6 +86,7 @@ static void slurp_symtab (bfd *);
 static void find_address_in_section (bfd *, asection *, void *);
 static void find_offset_in_section (bfd *, asection *);
 static void translate_addresses (bfd *, asection *);
+static void translate_addresses_batch (bfd *, asection *);
 
 /* Print a usage message to STREAM and exit with STATUS.  */
 
@@ -86,9 +102,11 @@ usage (FILE *stream, int status)
   -b --target=<bfdname>  Set the binary file format\n\
   -e --exe=<executable>  Set the input file name (default is a.out)\n\
   -i --inlines           Unwind inlined functions\n\
+     --index-dir=<dir>   Keep an index of translated addresses in <dir>\n\
   -j --section=<name>    Read section-relative offsets instead of addresses\n\
   -p --pretty-print      Make the output easier to read for humans\n\
   -s --basenames         Strip directory names\n\
+     --batch             Read all addresses before translating any of them\n\
   -f --functions         Show function names\n\
   -C --demangle[=style]  Demangle function names\n\
   -h --help              Display this information\n\
@@ -159,6 +177,7 @@ static const char *functionname;
 static unsigned int line;
 static unsigned int discriminator;
 static bfd_boolean found;
+static asection *found_section;
 
 /* Look for an address in a section.  This is called via
    bfd_map_over_sections.  */
@@ -187,6 +206,8 @@ find_address_in_section (bfd *abfd, asection *section,
   found = bfd_find_nearest_line_discriminator (abfd, section, syms, pc - vma,
                                                &filename, &functionname,
                                                &line, &discriminator);
+  if (found)
+    found_section = section;
 }
 
 /* Look for an offset in a section.  This is directly called.  */
@@ -211,6 +232,858 @@ find_offset_in_section (bfd *abfd, asection *section)
                                                &line, &discriminator);
 }
 
+/* Convert the hexadecimal address ADDR_HEX into an address in ABFD.  */
+
+static bfd_vma
+scan_address (bfd *abfd, const char *addr_hex)
+{
+  bfd_vma vma = bfd_scan_vma (addr_hex, NULL, 16);
+
+  if (bfd_get_flavour (abfd) == bfd_target_elf_flavour)
+    {
+      const struct elf_backend_data *bed = get_elf_backend_data (abfd);
+      bfd_vma sign = (bfd_vma) 1 << (bed->s->arch_size - 1);
+
+      vma &= (sign << 1) - 1;
+      if (bed->sign_extend_vma)
+	vma = (vma ^ sign) - sign;
+    }
+
+  return vma;
+}
+
+/* Print the address VMA, if requested.  */
+
+static void
+print_address (bfd *abfd, bfd_vma vma)
+{
+  if (with_addresses)
+    {
+      printf ("0x");
+      bfd_printf_vma (abfd, vma);
+
+      if (pretty_print)
+	printf (": ");
+      else
+	printf ("\n");
+    }
+}
+
+/* Print the output for an address which could not be found.  */
+
+static void
+print_unknown_location (void)
+{
+  if (with_functions)
+    {
+      if (pretty_print)
+	printf ("?? ");
+      else
+	printf ("??\n");
+    }
+  printf ("??:0\n");
+}
+
+/* Print one source location: the function name, if requested, and the
+   file name and line number.  */
+
+static void
+print_location (bfd *abfd, const char *file, const char *function,
+		unsigned int lineno, unsigned int disc)
+{
+  if (with_functions)
+    {
+      const char *name;
+      char *alloc = NULL;
+
+      name = function;
+      if (name == NULL || *name == '\0')
+	name = "??";
+      else if (do_demangle)
+	{
+	  alloc = bfd_demangle (abfd, name, DMGL_ANSI | DMGL_PARAMS);
+	  if (alloc != NULL)
+	    name = alloc;
+	}
+
+      printf ("%s", name);
+      if (pretty_print)
+	/* Note for translators:  This printf is used to join the
+	   function name just printed above to the line number/
+	   file name pair that is about to be printed below.  Eg:
+
+	     foo at 123:bar.c  */
+	printf (_(" at "));
+      else
+	printf ("\n");
+
+      if (alloc != NULL)
+	free (alloc);
+    }
+
+  if (base_names && file != NULL)
+    {
+      const char *h;
+
+      h = strrchr (file, '/');
+      if (h != NULL)
+	file = h + 1;
+    }
+
+  printf ("%s:", file ? file : "??");
+  if (lineno != 0)
+    {
+      if (disc != 0)
+	printf ("%u (discriminator %u)\n", lineno, disc);
+      else
+	printf ("%u\n", lineno);
+    }
+  else
+    printf ("?\n");
+}
+
+/* Print the text joining an inlined location to the location of the
+   function it was inlined into.  */
+
+static void
+print_inlined_by (void)
+{
+  if (pretty_print)
+    /* Note for translators: This printf is used to join the
+       line number/file name pair that has just been printed with
+       the line number/file name pair that is going to be printed
+       by the next iteration of the while loop.  Eg:
+
+	 123:bar.c (inlined by) 456:main.c  */
+    printf (_(" (inlined by) "));
+}
+
+/* A source location found for an address.  */
+
+struct source_location
+{
+  const char *filename;
+  const char *functionname;
+  unsigned int line;
+  unsigned int discriminator;
+};
+
+/* An address to translate, and the source locations found for it,
+   innermost first.  No locations means that nothing was found.  */
+
+struct address_entry
+{
+  bfd_vma pc;
+  /* The position of the address in the input.  */
+  size_t index;
+  struct source_location *locs;
+  unsigned int nlocs;
+};
+
+/* The file and function names found so far.  BFD may reuse the
+   storage of the names it returns, so they are copied here.  */
+
+static htab_t string_pool;
+
+/* Equality function for the string pool.  */
+
+static int
+eq_string (const void *a, const void *b)
+{
+  return strcmp ((const char *) a, (const char *) b) == 0;
+}
+
+/* Return the copy of STR in the string pool.  */
+
+static const char *
+intern_string (const char *str)
+{
+  void **slot;
+
+  if (str == NULL)
+    return NULL;
+
+  if (string_pool == NULL)
+    string_pool = htab_create_alloc (1024, htab_hash_string, eq_string,
+				     free, xcalloc, free);
+
+  slot = htab_find_slot (string_pool, str, INSERT);
+  if (*slot == NULL)
+    *slot = xstrdup (str);
+  return (const char *) *slot;
+}
+
+/* Add the location currently held in the global variables to ENTRY.
+   *ALLOC is the number of locations allocated for ENTRY.  */
+
+static void
+add_location (struct address_entry *entry, unsigned int *alloc)
+{
+  struct source_location *loc;
+
+  if (entry->nlocs >= *alloc)
+    {
+      *alloc = *alloc ? *alloc * 2 : 4;
+      entry->locs = (struct source_location *)
+	xrealloc (entry->locs, *alloc * sizeof (struct source_location));
+    }
+
+  loc = &entry->locs[entry->nlocs++];
+  loc->filename = intern_string (filename);
+  loc->functionname = intern_string (functionname);
+  loc->line = line;
+  loc->discriminator = discriminator;
+}
+
+/* The address index written and read by --index-dir.  This is a
+   cache of translated addresses for one file, named after its
+   build-id, so that translating the same addresses again does not
+   need to read the debugging information.
+
+   The file holds a header, then an array of entries sorted by
+   address, then an array of frames, then a string table.  The values
+   are in host byte order and the arrays are suitably aligned, so the
+   file can be mapped and used in place.  */
+
+#define INDEX_MAGIC "A2LINDEX"
+#define INDEX_VERSION 2
+#define INDEX_MAX_BUILD_ID 64
+#define INDEX_NO_STRING ((unsigned int) -1)
+
+struct index_header
+{
+  char magic[8];
+  unsigned int version;
+  /* These catch an index written by a different build of addr2line.  */
+  unsigned int header_size;
+  unsigned int vma_size;
+  unsigned int build_id_size;
+  unsigned char build_id[INDEX_MAX_BUILD_ID];
+  /* The size and modification time of the file the index was built
+     for.  These catch a file which was changed without changing its
+     build-id, for example by stripping it.  */
+  bfd_size_type file_size;
+  bfd_size_type file_mtime;
+  /* Everything above must match for the index to be used.  */
+  unsigned int entry_count;
+  unsigned int frame_count;
+  unsigned int string_size;
+  unsigned int pad;
+};
+
+struct index_entry
+{
+  bfd_vma pc;
+  /* The first frame for the address, and the number of frames.  */
+  unsigned int frame;
+  unsigned int frame_count;
+};
+
+struct index_frame
+{
+  /* Offsets into the string table, or INDEX_NO_STRING.  */
+  unsigned int filename;
+  unsigned int functionname;
+  unsigned int line;
+  unsigned int discriminator;
+};
+
+/* The name of the index file for the file being processed, or NULL
+   if there is no index.  */
+static char *index_name;
+
+/* The header that the index file must have to be up to date.  */
+static struct index_header index_key;
+
+/* The contents of the index file, if it was up to date.  */
+static void *index_contents;
+static size_t index_size;
+static bfd_boolean index_mapped;
+static const struct index_header *index_hdr;
+static const struct index_entry *index_entries;
+static const struct index_frame *index_frames;
+static const char *index_strings;
+
+/* The addresses translated which were not in the index, and their
+   locations.  The frame fields index NEW_FRAMES.  */
+static struct index_entry *new_entries;
+static size_t new_entry_count;
+static size_t new_entry_alloc;
+static struct source_location *new_frames;
+static size_t new_frame_count;
+static size_t new_frame_alloc;
+
+/* Release the contents of the index file.  */
+
+static void
+discard_index_contents (void)
+{
+  if (index_contents != NULL)
+    {
+#ifdef HAVE_MMAP
+      if (index_mapped)
+	munmap (index_contents, index_size);
+      else
+#endif
+	free (index_contents);
+    }
+  index_contents = NULL;
+  index_size = 0;
+  index_mapped = FALSE;
+  index_hdr = NULL;
+  index_entries = NULL;
+  index_frames = NULL;
+  index_strings = NULL;
+}
+
+/* Return TRUE if the contents of the index file are up to date and
+   consistent, and set up the pointers into them.  */
+
+static bfd_boolean
+check_index_contents (void)
+{
+  const struct index_header *hdr;
+  bfd_size_type size;
+
+  if (index_size < sizeof (struct index_header))
+    return FALSE;
+
+  hdr = (const struct index_header *) index_contents;
+  if (memcmp (hdr, &index_key, offsetof (struct index_header, entry_count))
+      != 0)
+    return FALSE;
+
+  size = (sizeof (struct index_header)
+	  + (bfd_size_type) hdr->entry_count * sizeof (struct index_entry)
+	  + (bfd_size_type) hdr->frame_count * sizeof (struct index_frame)
+	  + hdr->string_size);
+  if (size != index_size)
+    return FALSE;
+
+  index_hdr = hdr;
+  index_entries = (const struct index_entry *) (hdr + 1);
+  index_frames = (const struct index_frame *) (index_entries
+					      + hdr->entry_count);
+  index_strings = (const char *) (index_frames + hdr->frame_count);
+  if (hdr->string_size != 0 && index_strings[hdr->string_size - 1] != '\0')
+    return FALSE;
+
+  return TRUE;
+}
+
+/* Read the index file, if there is one and it is up to date.  */
+
+static void
+read_index (void)
+{
+  struct stat st;
+  int fd;
+
+  fd = open (index_name, O_RDONLY | O_BINARY);
+  if (fd < 0)
+    return;
+
+  if (fstat (fd, &st) != 0 || st.st_size <= 0)
+    {
+      close (fd);
+      return;
+    }
+  index_size = st.st_size;
+
+#ifdef HAVE_MMAP
+  index_contents = mmap (NULL, index_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (index_contents == MAP_FAILED)
+    index_contents = NULL;
+  else
+    index_mapped = TRUE;
+#endif
+  if (index_contents == NULL)
+    {
+      index_contents = xmalloc (index_size);
+      if (read (fd, index_contents, index_size) != (ssize_t) index_size)
+	{
+	  free (index_contents);
+	  index_contents = NULL;
+	}
+    }
+  close (fd);
+
+  /* A stale or damaged index is simply replaced when it is written.  */
+  if (index_contents != NULL && !check_index_contents ())
+    discard_index_contents ();
+}
+
+/* Set up the address index for ABFD, read from FILE_NAME.  */
+
+static void
+open_index (bfd *abfd, const char *file_name)
+{
+  const struct bfd_build_id *build_id = abfd->build_id;
+  struct stat st;
+  char *hex;
+  unsigned int i;
+
+  if (build_id == NULL
+      || build_id->size == 0
+      || build_id->size > INDEX_MAX_BUILD_ID
+      || stat (file_name, &st) != 0)
+    return;
+
+  memset (&index_key, 0, sizeof index_key);
+  memcpy (index_key.magic, INDEX_MAGIC, sizeof index_key.magic);
+  index_key.version = INDEX_VERSION;
+  index_key.header_size = sizeof (struct index_header);
+  index_key.vma_size = sizeof (bfd_vma);
+  index_key.build_id_size = build_id->size;
+  memcpy (index_key.build_id, build_id->data, build_id->size);
+  index_key.file_size = st.st_size;
+  index_key.file_mtime = st.st_mtime;
+
+  hex = (char *) xmalloc (build_id->size * 2 + 1);
+  for (i = 0; i < build_id->size; i++)
+    sprintf (hex + i * 2, "%02x", build_id->data[i]);
+  index_name = concat (index_dir, "/", hex, ".idx", (const char *) NULL);
+  free (hex);
+
+  read_index ();
+}
+
+/* Return TRUE if ENTRY, from the index file, refers to valid frames
+   and strings.  */
+
+static bfd_boolean
+index_entry_valid (const struct index_entry *entry)
+{
+  unsigned int i;
+
+  if (entry->frame > index_hdr->frame_count
+      || entry->frame_count > index_hdr->frame_count - entry->frame)
+    return FALSE;
+
+  for (i = 0; i < entry->frame_count; i++)
+    {
+      const struct index_frame *frame = &index_frames[entry->frame + i];
+
+      if ((frame->filename != INDEX_NO_STRING
+	   && frame->filename >= index_hdr->string_size)
+	  || (frame->functionname != INDEX_NO_STRING
+	      && frame->functionname >= index_hdr->string_size))
+	return FALSE;
+    }
+
+  return TRUE;
+}
+
+/* Return the string at OFFSET in the index file.  */
+
+static const char *
+index_string (unsigned int offset)
+{
+  return offset == INDEX_NO_STRING ? NULL : index_strings + offset;
+}
+
+/* Look up ENTRY->pc in the index file.  If it is there, fill in the
+   locations of ENTRY and return TRUE.  */
+
+static bfd_boolean
+lookup_index (struct address_entry *entry)
+{
+  const struct index_entry *found_entry;
+  unsigned int low, high, mid, i;
+
+  if (index_hdr == NULL)
+    return FALSE;
+
+  found_entry = NULL;
+  low = 0;
+  high = index_hdr->entry_count;
+  while (low < high)
+    {
+      mid = (low + high) / 2;
+      if (entry->pc < index_entries[mid].pc)
+	high = mid;
+      else if (entry->pc > index_entries[mid].pc)
+	low = mid + 1;
+      else
+	{
+	  found_entry = &index_entries[mid];
+	  break;
+	}
+    }
+
+  if (found_entry == NULL || !index_entry_valid (found_entry))
+    return FALSE;
+
+  entry->nlocs = found_entry->frame_count;
+  if (entry->nlocs != 0)
+    entry->locs = (struct source_location *)
+      xmalloc (entry->nlocs * sizeof (struct source_location));
+  for (i = 0; i < entry->nlocs; i++)
+    {
+      const struct index_frame *frame = &index_frames[found_entry->frame + i];
+      struct source_location *loc = &entry->locs[i];
+
+      loc->filename = index_string (frame->filename);
+      loc->functionname = index_string (frame->functionname);
+      loc->line = frame->line;
+      loc->discriminator = frame->discriminator;
+    }
+
+  return TRUE;
+}
+
+/* Remember ENTRY, which was not in the index file, so that it is
+   added when the index is written.  */
+
+static void
+record_index_entry (const struct address_entry *entry)
+{
+  struct index_entry *new_entry;
+
+  if (new_entry_count >= new_entry_alloc)
+    {
+      new_entry_alloc = new_entry_alloc ? new_entry_alloc * 2 : 256;
+      new_entries = (struct index_entry *)
+	xrealloc (new_entries, new_entry_alloc * sizeof (struct index_entry));
+    }
+  while (new_frame_count + entry->nlocs > new_frame_alloc)
+    {
+      new_frame_alloc = new_frame_alloc ? new_frame_alloc * 2 : 256;
+      new_frames = (struct source_location *)
+	xrealloc (new_frames,
+		  new_frame_alloc * sizeof (struct source_location));
+    }
+
+  new_entry = &new_entries[new_entry_count++];
+  new_entry->pc = entry->pc;
+  new_entry->frame = new_frame_count;
+  new_entry->frame_count = entry->nlocs;
+  if (entry->nlocs != 0)
+    memcpy (new_frames + new_frame_count, entry->locs,
+	    entry->nlocs * sizeof (struct source_location));
+  new_frame_count += entry->nlocs;
+}
+
+/* Sort index entries by address, then by the order they were added.  */
+
+static int
+compare_index_entries (const void *a, const void *b)
+{
+  const struct index_entry *entry1 = (const struct index_entry *) a;
+  const struct index_entry *entry2 = (const struct index_entry *) b;
+
+  if (entry1->pc != entry2->pc)
+    return entry1->pc < entry2->pc ? -1 : 1;
+  if (entry1->frame != entry2->frame)
+    return entry1->frame < entry2->frame ? -1 : 1;
+  return 0;
+}
+
+/* The string table of an index file being written.  */
+
+struct index_strtab
+{
+  /* Maps strings to struct index_string.  */
+  htab_t htab;
+  char *data;
+  size_t size;
+  size_t alloc;
+};
+
+struct index_string
+{
+  const char *str;
+  unsigned int offset;
+};
+
+static hashval_t
+hash_index_string (const void *p)
+{
+  return htab_hash_string (((const struct index_string *) p)->str);
+}
+
+static int
+eq_index_string (const void *a, const void *b)
+{
+  return strcmp (((const struct index_string *) a)->str,
+		 ((const struct index_string *) b)->str) == 0;
+}
+
+/* Add STR to STRTAB, returning its offset.  */
+
+static unsigned int
+add_index_string (struct index_strtab *strtab, const char *str)
+{
+  struct index_string key, *entry;
+  void **slot;
+  size_t len;
+
+  if (str == NULL)
+    return INDEX_NO_STRING;
+
+  key.str = str;
+  slot = htab_find_slot (strtab->htab, &key, INSERT);
+  if (*slot != NULL)
+    return ((struct index_string *) *slot)->offset;
+
+  len = strlen (str) + 1;
+  while (strtab->size + len > strtab->alloc)
+    {
+      strtab->alloc = strtab->alloc ? strtab->alloc * 2 : 4096;
+      strtab->data = (char *) xrealloc (strtab->data, strtab->alloc);
+    }
+
+  entry = (struct index_string *) xmalloc (sizeof (struct index_string));
+  entry->str = str;
+  entry->offset = strtab->size;
+  *slot = entry;
+
+  memcpy (strtab->data + strtab->size, str, len);
+  strtab->size += len;
+  return entry->offset;
+}
+
+/* Write the index file, adding the new entries to those already in
+   it.  The file is written under a temporary name and then renamed,
+   so that a concurrent reader never sees a partial index.  */
+
+static void
+write_index (void)
+{
+  struct index_header hdr;
+  struct index_entry *entries;
+  struct index_frame *frames;
+  struct index_strtab strtab;
+  size_t old_count, entry_count, frame_count, i, j, k;
+  char *tmpname;
+  FILE *f;
+  bfd_boolean ok;
+
+  if (new_entry_count == 0)
+    return;
+
+  qsort (new_entries, new_entry_count, sizeof (struct index_entry),
+	 compare_index_entries);
+
+  old_count = index_hdr != NULL ? index_hdr->entry_count : 0;
+  entries = (struct index_entry *)
+    xmalloc ((old_count + new_entry_count) * sizeof (struct index_entry));
+  frames = (struct index_frame *)
+    xmalloc (((index_hdr != NULL ? index_hdr->frame_count : 0)
+	      + new_frame_count) * sizeof (struct index_frame));
+  strtab.htab = htab_create_alloc (1024, hash_index_string, eq_index_string,
+				   free, xcalloc, free);
+  strtab.data = NULL;
+  strtab.size = 0;
+  strtab.alloc = 0;
+
+  /* Merge the old and new entries, dropping any duplicates.  */
+  entry_count = 0;
+  frame_count = 0;
+  i = 0;
+  j = 0;
+  while (i < old_count || j < new_entry_count)
+    {
+      struct index_entry *entry = &entries[entry_count];
+
+      if (j == new_entry_count
+	  || (i < old_count && index_entries[i].pc <= new_entries[j].pc))
+	{
+	  const struct index_entry *old_entry = &index_entries[i++];
+
+	  if (!index_entry_valid (old_entry)
+	      || (entry_count != 0
+		  && entries[entry_count - 1].pc == old_entry->pc))
+	    continue;
+
+	  entry->pc = old_entry->pc;
+	  entry->frame = frame_count;
+	  entry->frame_count = old_entry->frame_count;
+	  for (k = 0; k < old_entry->frame_count; k++)
+	    {
+	      const struct index_frame *old_frame
+		= &index_frames[old_entry->frame + k];
+	      struct index_frame *frame = &frames[frame_count++];
+
+	      frame->filename
+		= add_index_string (&strtab, index_string (old_frame->filename));
+	      frame->functionname
+		= add_index_string (&strtab,
+				    index_string (old_frame->functionname));
+	      frame->line = old_frame->line;
+	      frame->discriminator = old_frame->discriminator;
+	    }
+	}
+      else
+	{
+	  const struct index_entry *new_entry = &new_entries[j++];
+
+	  if (entry_count != 0 && entries[entry_count - 1].pc == new_entry->pc)
+	    continue;
+
+	  entry->pc = new_entry->pc;
+	  entry->frame = frame_count;
+	  entry->frame_count = new_entry->frame_count;
+	  for (k = 0; k < new_entry->frame_count; k++)
+	    {
+	      const struct source_location *loc
+		= &new_frames[new_entry->frame + k];
+	      struct index_frame *frame = &frames[frame_count++];
+
+	      frame->filename = add_index_string (&strtab, loc->filename);
+	      frame->functionname = add_index_string (&strtab,
+						      loc->functionname);
+	      frame->line = loc->line;
+	      frame->discriminator = loc->discriminator;
+	    }
+	}
+      entry_count++;
+    }
+
+  /* The old contents have been copied, and must not be left mapped
+     while the file is replaced.  */
+  discard_index_contents ();
+
+  hdr = index_key;
+  hdr.entry_count = entry_count;
+  hdr.frame_count = frame_count;
+  hdr.string_size = strtab.size;
+
+  ok = FALSE;
+  tmpname = NULL;
+  if (strtab.size < INDEX_NO_STRING && frame_count < INDEX_NO_STRING)
+    tmpname = make_tempname (index_name);
+  if (tmpname != NULL)
+    {
+      f = fopen (tmpname, FOPEN_WB);
+      if (f != NULL)
+	{
+	  ok = (fwrite (&hdr, sizeof hdr, 1, f) == 1
+		&& fwrite (entries, sizeof (struct index_entry), entry_count,
+			   f) == entry_count
+		&& fwrite (frames, sizeof (struct index_frame), frame_count,
+			   f) == frame_count
+		&& fwrite (strtab.data, 1, strtab.size, f) == strtab.size);
+	  if (fclose (f) != 0)
+	    ok = FALSE;
+	}
+      if (ok)
+	ok = rename (tmpname, index_name) == 0;
+      if (!ok)
+	unlink (tmpname);
+      free (tmpname);
+    }
+  if (!ok)
+    non_fatal (_("unable to write address index %s"), index_name);
+
+  htab_delete (strtab.htab);
+  free (strtab.data);
+  free (frames);
+  free (entries);
+}
+
+/* Release the address index.  */
+
+static void
+close_index (void)
+{
+  discard_index_contents ();
+  free (index_name);
+  index_name = NULL;
+  free (new_entries);
+  new_entries = NULL;
+  new_entry_count = 0;
+  new_entry_alloc = 0;
+  free (new_frames);
+  new_frames = NULL;
+  new_frame_count = 0;
+  new_frame_alloc = 0;
+}
+
+/* Find the source locations for ENTRY->pc, from the address index if
+   there is one, otherwise from the debugging information in ABFD.
+   SECTION is as for translate_addresses.  */
+
+static void
+resolve_address (bfd *abfd, asection *section, struct address_entry *entry)
+{
+  bfd_boolean use_index = index_name != NULL && section == NULL;
+  unsigned int alloc = 0;
+
+  entry->locs = NULL;
+  entry->nlocs = 0;
+  if (use_index && lookup_index (entry))
+    return;
+
+  if (!syms_read)
+    {
+      slurp_symtab (abfd);
+      syms_read = TRUE;
+    }
+
+  pc = entry->pc;
+  found = FALSE;
+  if (section)
+    find_offset_in_section (abfd, section);
+  else
+    {
+      /* In batch mode the addresses are sorted, so the next one is
+	 most likely in the same section as the last.  Sections of a
+	 relocatable object can overlap, so there only the walk in
+	 section order gives the section that the lookup would give
+	 without --batch.  */
+      if (batch_mode && found_section != NULL
+	  && (abfd->flags & (EXEC_P | DYNAMIC)) != 0)
+	find_address_in_section (abfd, found_section, NULL);
+      if (! found)
+	bfd_map_over_sections (abfd, find_address_in_section, NULL);
+    }
+
+  while (found)
+    {
+      add_location (entry, &alloc);
+      /* The index records the inlined functions even without -i,
+	 so that it can be used either way.  */
+      if (!unwind_inlines && !use_index)
+	found = FALSE;
+      else
+	found = bfd_find_inliner_info (abfd, &filename, &functionname,
+				       &line);
+    }
+
+  /* Only remember answers which came from line number information.
+     Anything less may just mean that the debugging information is in
+     a separate file which is not installed yet, and the index is not
+     invalidated when that file appears.  */
+  if (use_index && entry->nlocs != 0 && entry->locs[0].line != 0)
+    record_index_entry (entry);
+}
+
+/* Print the locations found for ENTRY.  */
+
+static void
+print_address_entry (bfd *abfd, const struct address_entry *entry)
+{
+  unsigned int i, count;
+
+  print_address (abfd, entry->pc);
+  if (entry->nlocs == 0)
+    {
+      print_unknown_location ();
+      return;
+    }
+
+  count = unwind_inlines ? entry->nlocs : 1;
+  for (i = 0; i < count; i++)
+    {
+      if (i != 0)
+	print_inlined_by ();
+      print_location (abfd, entry->locs[i].filename,
+		      entry->locs[i].functionname, entry->locs[i].line,
+		      entry->locs[i].discriminator);
+    }
+}
+
 /* Read hexadecimal addresses from stdin, translate into
    file_name:line_number and optionally function name.  */
 
@@ -221,137 +1094,147 @@ translate_addresses (bfd *abfd, asection *section)
 
   for (;;)
     {
+      struct address_entry entry;
+
       if (read_stdin)
 	{
 	  char addr_hex[100];
 
 	  if (fgets (addr_hex, sizeof addr_hex, stdin) == NULL)
 	    break;
-	  pc = bfd_scan_vma (addr_hex, NULL, 16);
+	  entry.pc = scan_address (abfd, addr_hex);
 	}
       else
 	{
 	  if (naddr <= 0)
 	    break;
 	  --naddr;
-	  pc = bfd_scan_vma (*addr++, NULL, 16);
+	  entry.pc = scan_address (abfd, *addr++);
 	}
 
-      if (bfd_get_flavour (abfd) == bfd_target_elf_flavour)
-	{
-	  const struct elf_backend_data *bed = get_elf_backend_data (abfd);
-	  bfd_vma sign = (bfd_vma) 1 << (bed->s->arch_size - 1);
+      resolve_address (abfd, section, &entry);
+      print_address_entry (abfd, &entry);
+      free (entry.locs);
 
-	  pc &= (sign << 1) - 1;
-	  if (bed->sign_extend_vma)
-	    pc = (pc ^ sign) - sign;
-	}
+      /* fflush() is essential for using this command as a server
+         child process that reads addresses from a pipe and responds
+         with line number information, processing one address at a
+         time.  */
+      fflush (stdout);
+    }
+}
+
+/* Sort address entries by address, then by input position.  */
+
+static int
+compare_address_entries (const void *a, const void *b)
+{
+  const struct address_entry *entry1 = *(const struct address_entry **) a;
+  const struct address_entry *entry2 = *(const struct address_entry **) b;
 
-      if (with_addresses)
-        {
-          printf ("0x");
-          bfd_printf_vma (abfd, pc);
+  if (entry1->pc != entry2->pc)
+    return entry1->pc < entry2->pc ? -1 : 1;
+  if (entry1->index != entry2->index)
+    return entry1->index < entry2->index ? -1 : 1;
+  return 0;
+}
 
-          if (pretty_print)
-            printf (": ");
-          else
-            printf ("\n");
-        }
+/* Like translate_addresses, but read all of the addresses first, then
+   look them up in address order, translating each distinct address
+   only once, and finally print the results in the input order.  This
+   is much faster for large numbers of addresses, such as those from
+   a collection of stack traces, but the output is not available
+   until all of the input has been read.  */
 
-      found = FALSE;
-      if (section)
-	find_offset_in_section (abfd, section);
-      else
-	bfd_map_over_sections (abfd, find_address_in_section, NULL);
+static void
+translate_addresses_batch (bfd *abfd, asection *section)
+{
+  struct address_entry *addrs = NULL;
+  struct address_entry **sorted;
+  struct address_entry *prev;
+  size_t count = 0;
+  size_t alloc = 0;
+  size_t i;
+  int read_stdin = (naddr == 0);
 
-      if (! found)
+  for (;;)
+    {
+      bfd_vma vma;
+
+      if (read_stdin)
 	{
-	  if (with_functions)
-	    {
-	      if (pretty_print)
-		printf ("?? ");
-	      else
-		printf ("??\n");
-	    }
-	  printf ("??:0\n");
+	  char addr_hex[100];
+
+	  if (fgets (addr_hex, sizeof addr_hex, stdin) == NULL)
+	    break;
+	  vma = scan_address (abfd, addr_hex);
 	}
       else
 	{
-	  while (1)
-            {
-              if (with_functions)
-                {
-                  const char *name;
-                  char *alloc = NULL;
-
-                  name = functionname;
-                  if (name == NULL || *name == '\0')
-                    name = "??";
-                  else if (do_demangle)
-                    {
-                      alloc = bfd_demangle (abfd, name, DMGL_ANSI | DMGL_PARAMS);
-                      if (alloc != NULL)
-                        name = alloc;
-                    }
-
-                  printf ("%s", name);
-                  if (pretty_print)
-		    /* Note for translators:  This printf is used to join the
-		       function name just printed above to the line number/
-		       file name pair that is about to be printed below.  Eg:
-
-		         foo at 123:bar.c  */
-                    printf (_(" at "));
-                  else
-                    printf ("\n");
-
-                  if (alloc != NULL)
-                    free (alloc);
-                }
-
-              if (base_names && filename != NULL)
-                {
-                  char *h;
-
-                  h = strrchr (filename, '/');
-                  if (h != NULL)
-                    filename = h + 1;
-                }
-
-              printf ("%s:", filename ? filename : "??");
-	      if (line != 0)
-                {
-                  if (discriminator != 0)
-                    printf ("%u (discriminator %u)\n", line, discriminator);
-                  else
-                    printf ("%u\n", line);
-                }
-	      else
-		printf ("?\n");
-              if (!unwind_inlines)
-                found = FALSE;
-              else
-                found = bfd_find_inliner_info (abfd, &filename, &functionname,
-					       &line);
-              if (! found)
-                break;
-              if (pretty_print)
-		/* Note for translators: This printf is used to join the
-		   line number/file name pair that has just been printed with
-		   the line number/file name pair that is going to be printed
-		   by the next iteration of the while loop.  Eg:
-
-		     123:bar.c (inlined by) 456:main.c  */
-                printf (_(" (inlined by) "));
-            }
+	  if (naddr <= 0)
+	    break;
+	  --naddr;
+	  vma = scan_address (abfd, *addr++);
+	}
+
+      if (count >= alloc)
+	{
+	  alloc = alloc ? alloc * 2 : 1024;
+	  addrs = (struct address_entry *)
+	    xrealloc (addrs, alloc * sizeof (struct address_entry));
 	}
+      addrs[count].pc = vma;
+      addrs[count].index = count;
+      addrs[count].locs = NULL;
+      addrs[count].nlocs = 0;
+      count++;
+    }
 
-      /* fflush() is essential for using this command as a server
-         child process that reads addresses from a pipe and responds
-         with line number information, processing one address at a
-         time.  */
-      fflush (stdout);
+  if (count == 0)
+    return;
+
+  /* Every address is going to be looked up, so have BFD read and
+     index all of the debugging information up front.  */
+  abfd->flags |= BFD_DWARF_EAGER;
+
+  sorted = (struct address_entry **) xmalloc (count * sizeof (*sorted));
+  for (i = 0; i < count; i++)
+    sorted[i] = &addrs[i];
+  qsort (sorted, count, sizeof (*sorted), compare_address_entries);
+
+  prev = NULL;
+  found_section = NULL;
+  for (i = 0; i < count; i++)
+    {
+      struct address_entry *entry = sorted[i];
+
+      if (prev != NULL && prev->pc == entry->pc)
+	{
+	  entry->locs = prev->locs;
+	  entry->nlocs = prev->nlocs;
+	  continue;
+	}
+      prev = entry;
+      resolve_address (abfd, section, entry);
+    }
+
+  for (i = 0; i < count; i++)
+    print_address_entry (abfd, &addrs[i]);
+  fflush (stdout);
+
+  /* Entries for the same address share their locations, and are
+     adjacent in SORTED, so free each set of locations once.  */
+  prev = NULL;
+  for (i = 0; i < count; i++)
+    {
+      struct address_entry *entry = sorted[i];
+
+      if (prev == NULL || prev->pc != entry->pc)
+	free (entry->locs);
+      prev = entry;
     }
+  free (sorted);
+  free (addrs);
 }
 
 /* Process a file.  Returns an exit value for main().  */
@@ -397,9 +1280,23 @@ process_file (const char *file_name, const char *section_name,
   else
     section = NULL;
 
-  slurp_symtab (abfd);
+  /* The symbol table is only read if an address is not found in the
+     address index.  */
+  syms_read = FALSE;
+
+  if (index_dir != NULL && section == NULL)
+    open_index (abfd, file_name);
+
+  if (batch_mode)
+    translate_addresses_batch (abfd, section);
+  else
+    translate_addresses (abfd, section);
 
-  translate_addresses (abfd, section);
+  if (index_name != NULL)
+    {
+      write_index ();
+      close_index ();
+    }
 
   if (syms != NULL)
     {
@@ -407,6 +1304,12 @@ process_file (const char *file_name, const char *section_name,
       syms = NULL;
     }
 
+  if (string_pool != NULL)
+    {
+      htab_delete (string_pool);
+      string_pool = NULL;
+    }
+
   bfd_close (abfd);
 
   return 0;
@@ -474,6 +1377,12 @@ main (int argc, char **argv)
 	case 's':
 	  base_names = TRUE;
 	  break;
+	case OPTION_BATCH:
+	  batch_mode = TRUE;
+	  break;
+	case OPTION_INDEX_DIR:
+	  index_dir = optarg;
+	  break;
 	case 'f':
 	  with_functions = TRUE;
 	  break;
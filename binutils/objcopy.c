@@ -207,7 +207,8 @@ static enum
   compress_zlib = compress | 1 << 1,
   compress_gnu_zlib = compress | 1 << 2,
   compress_gabi_zlib = compress | 1 << 3,
-  decompress = 1 << 4
+  decompress = 1 << 4,
+  compress_zstd = compress | 1 << 5
 } do_debug_sections = nothing;
 
 /* Whether to change the leading character in symbol names.  */
@@ -604,8 +605,9 @@ copy_usage (FILE *stream, int exit_status)
                                    <commit>\n\
      --subsystem <name>[:<version>]\n\
                                    Set PE subsystem to <name> [& <version>]\n\
-     --compress-debug-sections[={none|zlib|zlib-gnu|zlib-gabi}]\n\
+     --compress-debug-sections[={none|zlib|zlib-gnu|zlib-gabi|zstd}]\n\
                                    Compress DWARF debug sections using zlib\n\
+                                     or zstd\n\
      --decompress-debug-sections   Decompress DWARF debug sections using zlib\n\
   -v --verbose                     List all object files modified\n\
   @<file>                          Read options from <file>\n\
@@ -2604,11 +2606,14 @@ copy_file (const char *input_filename, const char *output_filename,
     case compress_zlib:
     case compress_gnu_zlib:
     case compress_gabi_zlib:
+    case compress_zstd:
       ibfd->flags |= BFD_COMPRESS;
       /* Don't check if input is ELF here since this information is
 	 only available after bfd_check_format_matches is called.  */
       if (do_debug_sections != compress_gnu_zlib)
 	ibfd->flags |= BFD_COMPRESS_GABI;
+      if (do_debug_sections == compress_zstd)
+	ibfd->flags |= BFD_COMPRESS_ZSTD;
       break;
     case decompress:
       ibfd->flags |= BFD_DECOMPRESS;
@@ -4038,6 +4043,13 @@ copy_main (int argc, char *argv[])
 		do_debug_sections = compress_gnu_zlib;
 	      else if (strcasecmp (optarg, "zlib-gabi") == 0)
 		do_debug_sections = compress_gabi_zlib;
+	      else if (strcasecmp (optarg, "zstd") == 0)
+		{
+		  if (!bfd_zstd_supported ())
+		    fatal (_("--compress-debug-sections=zstd: zstd support "
+			     "is not configured"));
+		  do_debug_sections = compress_zstd;
+		}
 	      else
 		fatal (_("unrecognized --compress-debug-sections type `%s'"),
 		       optarg);
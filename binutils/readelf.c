@@ -5876,6 +5876,8 @@ process_section_headers (FILE * file)
 		  get_compression_header (&chdr, buf);
 		  if (chdr.ch_type == ELFCOMPRESS_ZLIB)
 		    printf ("       ZLIB, ");
+		  else if (chdr.ch_type == ELFCOMPRESS_ZSTD)
+		    printf ("       ZSTD, ");
 		  else
 		    printf (_("       [<unknown>: 0x%x], "),
 			    chdr.ch_type);
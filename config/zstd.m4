@@ -0,0 +1,21 @@
+dnl A function to check whether to use an installed zstd library.
+dnl zstd is not used unless the user configured with --with-zstd,
+dnl since programs that link with libbfd.a must then also link with
+dnl $(ZSTD_LIBS).
+
+AC_DEFUN([AM_ZSTD],
+[
+  AC_ARG_WITH(zstd,
+  [AS_HELP_STRING([--with-zstd], [use installed libzstd for compressed debug sections])],
+  [], [with_zstd=no])
+  ZSTD_LIBS=
+  if test "x$with_zstd" != xno; then
+    AC_CHECK_HEADER(zstd.h,
+      [AC_CHECK_LIB(zstd, ZSTD_decompress, [ZSTD_LIBS=-lzstd])])
+    if test -z "$ZSTD_LIBS"; then
+      AC_MSG_ERROR([--with-zstd was given, but zstd was not found])
+    fi
+    AC_DEFINE(HAVE_ZSTD, 1, [Define if zstd compression is available.])
+  fi
+  AC_SUBST(ZSTD_LIBS)
+])
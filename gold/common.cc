@@ -53,56 +53,37 @@ Allocate_commons_task::locks(Task_locker* tl)
   tl->add(this, this->blocker_);
 }
 
-// Allocate the common symbols.
-
-void
-Allocate_commons_task::run(Workqueue*)
-{
-  this->symtab_->allocate_commons(this->layout_, this->mapfile_);
-}
-
-// This class is used to sort the common symbol.  We normally put the
+// This class is used to sort the common symbols.  We normally put the
 // larger common symbols first.  This can be changed by using
 // --sort-commons, which tells the linker to sort by alignment.
 
-template<int size>
-class Sort_commons
+class Sort_common_entries
 {
  public:
-  Sort_commons(const Symbol_table* symtab,
-	       Symbol_table::Sort_commons_order sort_order)
-    : symtab_(symtab), sort_order_(sort_order)
+  Sort_common_entries(Symbol_table::Sort_commons_order sort_order)
+    : sort_order_(sort_order)
   { }
 
-  bool operator()(const Symbol* a, const Symbol* b) const;
+  bool
+  operator()(const Symbol_table::Common_sort_entry& a,
+	     const Symbol_table::Common_sort_entry& b) const;
 
  private:
-  // The symbol table.
-  const Symbol_table* symtab_;
   // How to sort.
   Symbol_table::Sort_commons_order sort_order_;
 };
 
-template<int size>
 bool
-Sort_commons<size>::operator()(const Symbol* pa, const Symbol* pb) const
+Sort_common_entries::operator()(const Symbol_table::Common_sort_entry& a,
+				const Symbol_table::Common_sort_entry& b) const
 {
-  if (pa == NULL)
-    return false;
-  if (pb == NULL)
-    return true;
-
-  const Symbol_table* symtab = this->symtab_;
-  const Sized_symbol<size>* psa = symtab->get_sized_symbol<size>(pa);
-  const Sized_symbol<size>* psb = symtab->get_sized_symbol<size>(pb);
-
   // The size.
-  typename Sized_symbol<size>::Size_type sa = psa->symsize();
-  typename Sized_symbol<size>::Size_type sb = psb->symsize();
+  uint64_t sa = a.size;
+  uint64_t sb = b.size;
 
   // The alignment.
-  typename Sized_symbol<size>::Value_type aa = psa->value();
-  typename Sized_symbol<size>::Value_type ab = psb->value();
+  uint64_t aa = a.align;
+  uint64_t ab = b.align;
 
   if (this->sort_order_ == Symbol_table::SORT_COMMONS_BY_ALIGNMENT_DESCENDING)
     {
@@ -140,13 +121,188 @@ Sort_commons<size>::operator()(const Symbol* pa, const Symbol* pb) const
     }
 
   // Otherwise we stabilize the sort by sorting by name.
-  return strcmp(psa->name(), psb->name()) < 0;
+  return strcmp(a.name, b.name) < 0;
+}
+
+// Allocate the common symbols.  When using threads and there are
+// many common symbols, we sort them in parallel: we queue a
+// Sort_commons_task for each part of each list, and an
+// Allocate_sorted_commons_task to merge the parts and allocate the
+// symbols.  That task takes over our blocker.
+
+void
+Allocate_commons_task::run(Workqueue* workqueue)
+{
+  if (!parameters->options().threads())
+    {
+      this->symtab_->allocate_commons(this->layout_, this->mapfile_);
+      return;
+    }
+
+  Symbol_table::Commons_to_sort* to_sort = new Symbol_table::Commons_to_sort;
+  this->symtab_->gather_commons(to_sort);
+
+  size_t total = 0;
+  for (int i = 0; i < Symbol_table::commons_section_type_count; ++i)
+    total += to_sort->lists[i].size();
+
+  // Don't bother with separate tasks unless each part is large
+  // enough to make it worthwhile.
+  const size_t min_chunk = 32768;
+  const size_t max_chunks = 16;
+  if (total < 2 * min_chunk)
+    {
+      for (int i = 0; i < Symbol_table::commons_section_type_count; ++i)
+	{
+	  Symbol_table::Common_sort_list& list(to_sort->lists[i]);
+	  if (!list.empty())
+	    Symbol_table::sort_commons(to_sort->sort_order, &list[0],
+				       &list[0] + list.size());
+	}
+      this->symtab_->allocate_sorted_commons(this->layout_, this->mapfile_,
+					     to_sort);
+      delete to_sort;
+      return;
+    }
+
+  size_t chunk_size = std::max(min_chunk, total / max_chunks);
+  std::vector<size_t>* chunks =
+    new std::vector<size_t>[Symbol_table::commons_section_type_count];
+  int chunk_count = 0;
+  for (int i = 0; i < Symbol_table::commons_section_type_count; ++i)
+    {
+      size_t list_size = to_sort->lists[i].size();
+      for (size_t start = 0; start < list_size; start += chunk_size)
+	{
+	  chunks[i].push_back(start);
+	  ++chunk_count;
+	}
+    }
+
+  // Add all the blockers before queuing any of the tasks which
+  // release them.
+  Task_token* sort_blocker = new Task_token(true);
+  sort_blocker->add_blockers(chunk_count);
+  for (int i = 0; i < Symbol_table::commons_section_type_count; ++i)
+    {
+      Symbol_table::Common_sort_list& list(to_sort->lists[i]);
+      for (size_t j = 0; j < chunks[i].size(); ++j)
+	{
+	  size_t start = chunks[i][j];
+	  size_t end = std::min(start + chunk_size, list.size());
+	  workqueue->queue_soon(new Sort_commons_task(to_sort->sort_order,
+						      &list[0] + start,
+						      &list[0] + end,
+						      sort_blocker));
+	}
+    }
+
+  workqueue->add_blocker(this->blocker_);
+  workqueue->queue_soon(new Allocate_sorted_commons_task(this->symtab_,
+							 this->layout_,
+							 this->mapfile_,
+							 to_sort, chunks,
+							 sort_blocker,
+							 this->blocker_));
+}
+
+// Sort_commons_task methods.
+
+// Release the blocker when done.
+
+void
+Sort_commons_task::locks(Task_locker* tl)
+{
+  tl->add(this, this->blocker_);
+}
+
+// Sort the entries.
+
+void
+Sort_commons_task::run(Workqueue*)
+{
+  Symbol_table::sort_commons(this->sort_order_, this->begin_, this->end_);
+}
+
+// Allocate_sorted_commons_task methods.
+
+Allocate_sorted_commons_task::~Allocate_sorted_commons_task()
+{
+  delete this->sort_blocker_;
+}
+
+// Wait until all the parts have been sorted.
+
+Task_token*
+Allocate_sorted_commons_task::is_runnable()
+{
+  if (this->sort_blocker_->is_blocked())
+    return this->sort_blocker_;
+  return NULL;
+}
+
+// Release a blocker.
+
+void
+Allocate_sorted_commons_task::locks(Task_locker* tl)
+{
+  tl->add(this, this->blocker_);
+}
+
+// Merge the sorted parts of each list, and allocate the symbols.
+// The merge produces the same order as sorting each list in one
+// piece.
+
+void
+Allocate_sorted_commons_task::run(Workqueue*)
+{
+  Symbol_table::Commons_to_sort* to_sort = this->to_sort_;
+  for (int i = 0; i < Symbol_table::commons_section_type_count; ++i)
+    {
+      Symbol_table::Common_sort_list& list(to_sort->lists[i]);
+      const std::vector<size_t>& starts(this->chunks_[i]);
+      Sort_common_entries cmp(to_sort->sort_order);
+      for (size_t j = 1; j < starts.size(); ++j)
+	{
+	  Symbol_table::Common_sort_list::iterator mid =
+	    list.begin() + starts[j];
+	  Symbol_table::Common_sort_list::iterator end =
+	    (j + 1 < starts.size()
+	     ? list.begin() + starts[j + 1]
+	     : list.end());
+	  std::inplace_merge(list.begin(), mid, end, cmp);
+	}
+    }
+
+  this->symtab_->allocate_sorted_commons(this->layout_, this->mapfile_,
+					 to_sort);
+  delete to_sort;
+  this->to_sort_ = NULL;
+  delete[] this->chunks_;
+  this->chunks_ = NULL;
 }
 
 // Allocate the common symbols.
 
 void
 Symbol_table::allocate_commons(Layout* layout, Mapfile* mapfile)
+{
+  Commons_to_sort to_sort;
+  this->gather_commons(&to_sort);
+  for (int i = 0; i < commons_section_type_count; ++i)
+    {
+      Common_sort_list& list(to_sort.lists[i]);
+      if (!list.empty())
+	Symbol_table::sort_commons(to_sort.sort_order, &list[0],
+				   &list[0] + list.size());
+    }
+  this->allocate_sorted_commons(layout, mapfile, &to_sort);
+}
+
+// Gather the common symbols into TO_SORT, and set the sort order.
+
+void
+Symbol_table::gather_commons(Commons_to_sort* to_sort)
 {
   Sort_commons_order sort_order;
   if (!parameters->options().user_set_sort_common())
@@ -164,11 +320,12 @@ Symbol_table::allocate_commons(Layout* layout, Mapfile* mapfile)
 	  sort_order = SORT_COMMONS_BY_SIZE_DESCENDING;
 	}
     }
+  to_sort->sort_order = sort_order;
 
   if (parameters->target().get_size() == 32)
     {
 #if defined(HAVE_TARGET_32_LITTLE) || defined(HAVE_TARGET_32_BIG)
-      this->do_allocate_commons<32>(layout, mapfile, sort_order);
+      this->do_gather_commons<32>(to_sort);
 #else
       gold_unreachable();
 #endif
@@ -176,7 +333,7 @@ Symbol_table::allocate_commons(Layout* layout, Mapfile* mapfile)
   else if (parameters->target().get_size() == 64)
     {
 #if defined(HAVE_TARGET_64_LITTLE) || defined(HAVE_TARGET_64_BIG)
-      this->do_allocate_commons<64>(layout, mapfile, sort_order);
+      this->do_gather_commons<64>(to_sort);
 #else
       gold_unreachable();
 #endif
@@ -185,74 +342,112 @@ Symbol_table::allocate_commons(Layout* layout, Mapfile* mapfile)
     gold_unreachable();
 }
 
-// Allocated the common symbols, sized version.
+// Gather the common symbols, sized version.
 
 template<int size>
 void
-Symbol_table::do_allocate_commons(Layout* layout, Mapfile* mapfile,
-				  Sort_commons_order sort_order)
+Symbol_table::do_gather_commons(Commons_to_sort* to_sort)
 {
-  if (!this->commons_.empty())
-    this->do_allocate_commons_list<size>(layout, COMMONS_NORMAL,
-					 &this->commons_, mapfile,
-					 sort_order);
-  if (!this->tls_commons_.empty())
-    this->do_allocate_commons_list<size>(layout, COMMONS_TLS,
-					 &this->tls_commons_, mapfile,
-					 sort_order);
-  if (!this->small_commons_.empty())
-    this->do_allocate_commons_list<size>(layout, COMMONS_SMALL,
-					 &this->small_commons_, mapfile,
-					 sort_order);
-  if (!this->large_commons_.empty())
-    this->do_allocate_commons_list<size>(layout, COMMONS_LARGE,
-					 &this->large_commons_, mapfile,
-					 sort_order);
+  this->do_gather_commons_list<size>(&this->commons_,
+				     &to_sort->lists[COMMONS_NORMAL]);
+  this->do_gather_commons_list<size>(&this->tls_commons_,
+				     &to_sort->lists[COMMONS_TLS]);
+  this->do_gather_commons_list<size>(&this->small_commons_,
+				     &to_sort->lists[COMMONS_SMALL]);
+  this->do_gather_commons_list<size>(&this->large_commons_,
+				     &to_sort->lists[COMMONS_LARGE]);
 }
 
-// Allocate the common symbols in a list.  IS_TLS indicates whether
-// these are TLS common symbols.
+// Gather the common symbols in COMMONS into LIST, and clear COMMONS.
 
 template<int size>
 void
-Symbol_table::do_allocate_commons_list(
-    Layout* layout,
-    Commons_section_type commons_section_type,
-    Commons_type* commons,
-    Mapfile* mapfile,
-    Sort_commons_order sort_order)
+Symbol_table::do_gather_commons_list(Commons_type* commons,
+				     Common_sort_list* list)
 {
   // We've kept a list of all the common symbols.  But the symbol may
   // have been resolved to a defined symbol by now.  And it may be a
-  // forwarder.  First remove all non-common symbols.
-  bool any = false;
-  uint64_t addralign = 0;
+  // forwarder.  Only keep the symbols which are still common.
+  list->reserve(commons->size());
   for (Commons_type::iterator p = commons->begin();
        p != commons->end();
        ++p)
     {
       Symbol* sym = *p;
       if (sym->is_forwarder())
+	sym = this->resolve_forwards(sym);
+      if (!sym->is_common())
+	continue;
+      Sized_symbol<size>* ssym = this->get_sized_symbol<size>(sym);
+      Common_sort_entry e;
+      e.align = ssym->value();
+      e.size = ssym->symsize();
+      e.name = ssym->name();
+      e.sym = sym;
+      list->push_back(e);
+    }
+  commons->clear();
+}
+
+// Sort the common symbols from BEGIN to END.
+
+void
+Symbol_table::sort_commons(Sort_commons_order sort_order,
+			   Common_sort_entry* begin, Common_sort_entry* end)
+{
+  std::sort(begin, end, Sort_common_entries(sort_order));
+}
+
+// Allocate the sorted common symbols.
+
+void
+Symbol_table::allocate_sorted_commons(Layout* layout, Mapfile* mapfile,
+				      Commons_to_sort* to_sort)
+{
+  static const Commons_section_type types[] =
+    { COMMONS_NORMAL, COMMONS_TLS, COMMONS_SMALL, COMMONS_LARGE };
+  for (int i = 0; i < commons_section_type_count; ++i)
+    {
+      Common_sort_list* list = &to_sort->lists[types[i]];
+      if (list->empty())
+	continue;
+      if (parameters->target().get_size() == 32)
 	{
-	  sym = this->resolve_forwards(sym);
-	  *p = sym;
+#if defined(HAVE_TARGET_32_LITTLE) || defined(HAVE_TARGET_32_BIG)
+	  this->do_allocate_commons_list<32>(layout, types[i], list, mapfile);
+#else
+	  gold_unreachable();
+#endif
 	}
-      if (!sym->is_common())
-	*p = NULL;
-      else
+      else if (parameters->target().get_size() == 64)
 	{
-	  any = true;
-	  Sized_symbol<size>* ssym = this->get_sized_symbol<size>(sym);
-	  if (ssym->value() > addralign)
-	    addralign = ssym->value();
+#if defined(HAVE_TARGET_64_LITTLE) || defined(HAVE_TARGET_64_BIG)
+	  this->do_allocate_commons_list<64>(layout, types[i], list, mapfile);
+#else
+	  gold_unreachable();
+#endif
 	}
+      else
+	gold_unreachable();
     }
-  if (!any)
-    return;
+}
 
-  // Sort the common symbols.
-  std::sort(commons->begin(), commons->end(),
-	    Sort_commons<size>(this, sort_order));
+// Allocate the sorted common symbols in a list.
+
+template<int size>
+void
+Symbol_table::do_allocate_commons_list(
+    Layout* layout,
+    Commons_section_type commons_section_type,
+    Common_sort_list* list,
+    Mapfile* mapfile)
+{
+  uint64_t addralign = 0;
+  for (Common_sort_list::const_iterator p = list->begin();
+       p != list->end();
+       ++p)
+    if (p->align > addralign)
+      addralign = p->align;
 
   // Place them in a newly allocated BSS section.
   elfcpp::Elf_Xword flags = elfcpp::SHF_WRITE | elfcpp::SHF_ALLOC;
@@ -311,13 +506,11 @@ Symbol_table::do_allocate_commons_list(
   // Allocate them all.
 
   off_t off = 0;
-  for (Commons_type::iterator p = commons->begin();
-       p != commons->end();
+  for (Common_sort_list::const_iterator p = list->begin();
+       p != list->end();
        ++p)
     {
-      Symbol* sym = *p;
-      if (sym == NULL)
-	break;
+      Symbol* sym = p->sym;
 
       // Because we followed forwarding symbols above, but we didn't
       // do it reliably before adding symbols to the list, it is
@@ -358,7 +551,7 @@ Symbol_table::do_allocate_commons_list(
   if (poc != NULL)
     poc->set_current_data_size(off);
 
-  commons->clear();
+  list->clear();
 }
 
 } // End namespace gold.
@@ -24,6 +24,7 @@
 #define GOLD_COMMON_H
 
 #include "workqueue.h"
+#include "symtab.h"
 
 namespace gold
 {
@@ -62,6 +63,88 @@ class Allocate_commons_task : public Task
   Task_token* blocker_;
 };
 
+// This task sorts part of a list of common symbols, when the sorting
+// is done in parallel.
+
+class Sort_commons_task : public Task
+{
+ public:
+  Sort_commons_task(Symbol_table::Sort_commons_order sort_order,
+		    Symbol_table::Common_sort_entry* begin,
+		    Symbol_table::Common_sort_entry* end,
+		    Task_token* blocker)
+    : sort_order_(sort_order), begin_(begin), end_(end), blocker_(blocker)
+  { }
+
+  // The standard Task methods.
+
+  Task_token*
+  is_runnable()
+  { return NULL; }
+
+  void
+  locks(Task_locker*);
+
+  void
+  run(Workqueue*);
+
+  std::string
+  get_name() const
+  { return "Sort_commons_task"; }
+
+ private:
+  Symbol_table::Sort_commons_order sort_order_;
+  Symbol_table::Common_sort_entry* begin_;
+  Symbol_table::Common_sort_entry* end_;
+  Task_token* blocker_;
+};
+
+// This task merges the parts sorted by the Sort_commons_tasks and
+// then allocates the common symbols.
+
+class Allocate_sorted_commons_task : public Task
+{
+ public:
+  // CHUNKS holds, for each list in TO_SORT, the indexes at which the
+  // separately sorted parts of the list start.  SORT_BLOCKER is
+  // blocked until all the parts are sorted.
+  Allocate_sorted_commons_task(Symbol_table* symtab, Layout* layout,
+			       Mapfile* mapfile,
+			       Symbol_table::Commons_to_sort* to_sort,
+			       std::vector<size_t>* chunks,
+			       Task_token* sort_blocker, Task_token* blocker)
+    : symtab_(symtab), layout_(layout), mapfile_(mapfile),
+      to_sort_(to_sort), chunks_(chunks), sort_blocker_(sort_blocker),
+      blocker_(blocker)
+  { }
+
+  ~Allocate_sorted_commons_task();
+
+  // The standard Task methods.
+
+  Task_token*
+  is_runnable();
+
+  void
+  locks(Task_locker*);
+
+  void
+  run(Workqueue*);
+
+  std::string
+  get_name() const
+  { return "Allocate_sorted_commons_task"; }
+
+ private:
+  Symbol_table* symtab_;
+  Layout* layout_;
+  Mapfile* mapfile_;
+  Symbol_table::Commons_to_sort* to_sort_;
+  std::vector<size_t>* chunks_;
+  Task_token* sort_blocker_;
+  Task_token* blocker_;
+};
+
 } // End namespace gold.
 
 #endif // !defined(GOLD_COMMON_H)
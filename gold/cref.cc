@@ -22,6 +22,7 @@
 
 #include "gold.h"
 
+#include <algorithm>
 #include <cerrno>
 #include <cstdio>
 #include <cstring>
@@ -32,6 +33,7 @@
 #include "object.h"
 #include "archive.h"
 #include "symtab.h"
+#include "mapfile.h"
 #include "cref.h"
 
 namespace gold
@@ -66,7 +68,7 @@ class Cref_inputs
 
   // Print a cross reference table.
   void
-  print_cref(const Symbol_table*, FILE*) const;
+  print_cref(const Symbol_table*, FILE*, bool is_json) const;
 
  private:
   // A list of input objects.
@@ -88,8 +90,10 @@ class Cref_inputs
   typedef std::map<std::string, Archive_info> Archives;
 
   // For --cref, we build a cross reference table which maps from
-  // symbols to lists of objects.  The symbols are sorted
-  // alphabetically.
+  // symbols to lists of objects.  We print the symbols sorted
+  // alphabetically, but we only sort them once the table is
+  // complete, so that adding each reference is a hash table lookup
+  // rather than a series of string comparisons.
 
   class Cref_table_compare
   {
@@ -98,7 +102,7 @@ class Cref_inputs
     operator()(const Symbol*, const Symbol*) const;
   };
 
-  typedef std::map<const Symbol*, Objects*, Cref_table_compare> Cref_table;
+  typedef Unordered_map<const Symbol*, Objects*> Cref_table;
 
   // Report symbol counts for a list of Objects.
   void
@@ -284,7 +288,7 @@ static const size_t filecol = 50;
 // Print a cross reference table.
 
 void
-Cref_inputs::print_cref(const Symbol_table*, FILE* f) const
+Cref_inputs::print_cref(const Symbol_table*, FILE* f, bool is_json) const
 {
   Cref_table table;
   this->gather_cref(&this->objects_, &table);
@@ -293,13 +297,21 @@ Cref_inputs::print_cref(const Symbol_table*, FILE* f) const
        ++p)
     this->gather_cref(p->second.objects, &table);
 
+  std::vector<const Symbol*> symbols;
+  symbols.reserve(table.size());
   for (Cref_table::const_iterator pc = table.begin();
        pc != table.end();
        ++pc)
+    symbols.push_back(pc->first);
+  std::sort(symbols.begin(), symbols.end(), Cref_table_compare());
+
+  for (std::vector<const Symbol*>::const_iterator ps = symbols.begin();
+       ps != symbols.end();
+       ++ps)
     {
       // If all the objects are dynamic, skip this symbol.
-      const Symbol* sym = pc->first;
-      const Objects* objects = pc->second;
+      const Symbol* sym = *ps;
+      const Objects* objects = table[sym];
       Objects::const_iterator po;
       for (po = objects->begin(); po != objects->end(); ++po)
 	if (!(*po)->is_dynamic())
@@ -316,6 +328,21 @@ Cref_inputs::print_cref(const Symbol_table*, FILE* f) const
 	  s += sym->version();
 	}
 
+      if (is_json)
+	{
+	  fprintf(f, "{\"type\":\"cref\",\"symbol\":");
+	  Mapfile::print_json_string(f, s.c_str());
+	  fprintf(f, ",\"files\":[");
+	  for (po = objects->begin(); po != objects->end(); ++po)
+	    {
+	      if (po != objects->begin())
+		putc(',', f);
+	      Mapfile::print_json_string(f, (*po)->name().c_str());
+	    }
+	  fprintf(f, "]}\n");
+	  continue;
+	}
+
       fputs(s.c_str(), f);
 
       size_t len = s.length();
@@ -393,15 +420,18 @@ Cref::print_symbol_counts(const Symbol_table* symtab) const
 // Print a cross reference table.
 
 void
-Cref::print_cref(const Symbol_table* symtab, FILE* f) const
+Cref::print_cref(const Symbol_table* symtab, FILE* f, bool is_json) const
 {
-  fprintf(f, _("\nCross Reference Table\n\n"));
-  const char* msg = _("Symbol");
-  int len = filecol - strlen(msg);
-  fprintf(f, "%s%*c%s\n", msg, len, ' ', _("File"));
+  if (!is_json)
+    {
+      fprintf(f, _("\nCross Reference Table\n\n"));
+      const char* msg = _("Symbol");
+      int len = filecol - strlen(msg);
+      fprintf(f, "%s%*c%s\n", msg, len, ' ', _("File"));
+    }
 
   if (parameters->options().cref() && this->inputs_ != NULL)
-    this->inputs_->print_cref(symtab, f);
+    this->inputs_->print_cref(symtab, f, is_json);
 }
 
 } // End namespace gold.
@@ -63,9 +63,9 @@ class Cref
   void
   print_symbol_counts(const Symbol_table*) const;
 
-  // Print a cross reference table.
+  // Print a cross reference table, as JSON if IS_JSON.
   void
-  print_cref(const Symbol_table*, FILE*) const;
+  print_cref(const Symbol_table*, FILE*, bool is_json) const;
 
  private:
   void
@@ -23,20 +23,249 @@
 #include "gold.h"
 
 #include <cerrno>
+#include <cstdio>
 #include <cstring>
+#include <ctime>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <dirent.h>
+#include <unistd.h>
 
 #include "debug.h"
+#include "fileread.h"
 #include "gold-threads.h"
 #include "options.h"
+#include "parameters.h"
 #include "workqueue.h"
 #include "dirsearch.h"
 
 namespace
 {
 
+// A persistent cache of directory contents, stored in a file named by
+// --library-path-cache.  Each entry records the modification time of
+// the directory when it was read.  Creating, deleting or renaming a
+// file in a directory changes its modification time, so an entry is
+// valid as long as the time has not changed.  This lets a link skip
+// reading library directories which have not changed since the last
+// link which used the same cache file.
+
+class Persistent_dir_cache
+{
+ public:
+  typedef std::vector<std::string> File_list;
+
+  Persistent_dir_cache(const char* filename)
+    : filename_(filename), lock_(), entries_(), is_dirty_(false)
+  { }
+
+  // Read the cache file.  A missing or malformed file is treated as
+  // an empty cache.
+  void
+  load();
+
+  // If we have an entry for DIRNAME which was recorded with
+  // modification time MTIME, add the files to *FILES and return true.
+  bool
+  lookup(const std::string& dirname, const gold::Timespec& mtime,
+	 Unordered_set<std::string>* files);
+
+  // Record the files in DIRNAME, read when it had modification time
+  // MTIME.
+  void
+  update(const std::string& dirname, const gold::Timespec& mtime,
+	 const Unordered_set<std::string>& files);
+
+  // Write out the cache file if anything changed.
+  void
+  save();
+
+ private:
+  // We can not copy this class.
+  Persistent_dir_cache(const Persistent_dir_cache&);
+  Persistent_dir_cache& operator=(const Persistent_dir_cache&);
+
+  struct Entry
+  {
+    gold::Timespec mtime;
+    File_list files;
+  };
+
+  typedef Unordered_map<std::string, Entry> Entries;
+
+  // The version string at the start of the file.
+  static const char file_header[];
+
+  // Read a line from F into *LINE, without the newline.
+  static bool
+  read_line(FILE* f, std::string* line);
+
+  const char* filename_;
+  gold::Lock lock_;
+  Entries entries_;
+  bool is_dirty_;
+};
+
+const char Persistent_dir_cache::file_header[] = "gold-library-path-cache 1";
+
+bool
+Persistent_dir_cache::read_line(FILE* f, std::string* line)
+{
+  line->clear();
+  char buf[256];
+  while (fgets(buf, sizeof buf, f) != NULL)
+    {
+      size_t len = strlen(buf);
+      if (len > 0 && buf[len - 1] == '\n')
+	{
+	  line->append(buf, len - 1);
+	  return true;
+	}
+      line->append(buf, len);
+    }
+  return false;
+}
+
+void
+Persistent_dir_cache::load()
+{
+  FILE* f = fopen(this->filename_, "r");
+  if (f == NULL)
+    return;
+
+  std::string line;
+  bool ok = read_line(f, &line) && line == file_header;
+  std::string dirname;
+  std::string name;
+  while (ok && read_line(f, &line))
+    {
+      long long seconds;
+      int nanoseconds;
+      unsigned int count;
+      if (!read_line(f, &dirname)
+	  || sscanf(line.c_str(), "D %lld %d %u", &seconds, &nanoseconds,
+		    &count) != 3)
+	{
+	  ok = false;
+	  break;
+	}
+      Entry& entry(this->entries_[dirname]);
+      entry.mtime = gold::Timespec(seconds, nanoseconds);
+      entry.files.clear();
+      // COUNT comes from the file, so read the names one at a time
+      // rather than trusting it to size the list.
+      for (unsigned int i = 0; i < count; ++i)
+	{
+	  if (!read_line(f, &name))
+	    {
+	      ok = false;
+	      break;
+	    }
+	  entry.files.push_back(name);
+	}
+    }
+
+  fclose(f);
+
+  if (!ok)
+    this->entries_.clear();
+}
+
+bool
+Persistent_dir_cache::lookup(const std::string& dirname,
+			     const gold::Timespec& mtime,
+			     Unordered_set<std::string>* files)
+{
+  gold::Hold_lock hl(this->lock_);
+  Entries::const_iterator p = this->entries_.find(dirname);
+  if (p == this->entries_.end()
+      || p->second.mtime.seconds != mtime.seconds
+      || p->second.mtime.nanoseconds != mtime.nanoseconds)
+    return false;
+  files->insert(p->second.files.begin(), p->second.files.end());
+  return true;
+}
+
+void
+Persistent_dir_cache::update(const std::string& dirname,
+			     const gold::Timespec& mtime,
+			     const Unordered_set<std::string>& files)
+{
+  // If the directory was modified within the last couple of seconds,
+  // it may be modified again without its time changing on a file
+  // system with coarse timestamps, so don't trust the entry.
+  if (mtime.seconds + 2 >= time(NULL))
+    return;
+
+  Entry entry;
+  entry.mtime = mtime;
+  entry.files.reserve(files.size());
+  for (Unordered_set<std::string>::const_iterator p = files.begin();
+       p != files.end();
+       ++p)
+    {
+      // We store one name per line.
+      if (p->find('\n') != std::string::npos)
+	return;
+      entry.files.push_back(*p);
+    }
+
+  gold::Hold_lock hl(this->lock_);
+  this->entries_[dirname] = entry;
+  this->is_dirty_ = true;
+}
+
+// Write the cache to a temporary file and rename it into place, so
+// that a concurrent link never sees a partially written cache.
+
+void
+Persistent_dir_cache::save()
+{
+  gold::Hold_lock hl(this->lock_);
+  if (!this->is_dirty_)
+    return;
+  this->is_dirty_ = false;
+
+  char pid[32];
+  snprintf(pid, sizeof pid, ".%ld", static_cast<long>(getpid()));
+  std::string tmpname = std::string(this->filename_) + pid;
+  FILE* f = fopen(tmpname.c_str(), "w");
+  if (f == NULL)
+    {
+      gold::gold_warning(_("%s: can not create library path cache: %s"),
+			 tmpname.c_str(), strerror(errno));
+      return;
+    }
+
+  fprintf(f, "%s\n", file_header);
+  for (Entries::const_iterator p = this->entries_.begin();
+       p != this->entries_.end();
+       ++p)
+    {
+      const Entry& entry(p->second);
+      fprintf(f, "D %lld %d %u\n%s\n",
+	      static_cast<long long>(entry.mtime.seconds),
+	      entry.mtime.nanoseconds,
+	      static_cast<unsigned int>(entry.files.size()),
+	      p->first.c_str());
+      for (File_list::const_iterator q = entry.files.begin();
+	   q != entry.files.end();
+	   ++q)
+	fprintf(f, "%s\n", q->c_str());
+    }
+
+  if (fclose(f) != 0 || rename(tmpname.c_str(), this->filename_) != 0)
+    {
+      gold::gold_warning(_("%s: can not write library path cache: %s"),
+			 this->filename_, strerror(errno));
+      unlink(tmpname.c_str());
+    }
+}
+
+// The persistent cache, if --library-path-cache was used.
+
+Persistent_dir_cache* persistent_cache;
+
 // Read all the files in a directory.
 
 class Dir_cache
@@ -64,6 +293,22 @@ class Dir_cache
 void
 Dir_cache::read_files()
 {
+  gold::Timespec mtime;
+  if (persistent_cache != NULL)
+    {
+      struct stat st;
+      if (stat(this->dirname_, &st) == 0 && S_ISDIR(st.st_mode))
+	{
+#ifdef HAVE_STAT_ST_MTIM
+	  mtime = gold::Timespec(st.st_mtim.tv_sec, st.st_mtim.tv_nsec);
+#else
+	  mtime = gold::Timespec(st.st_mtime, 0);
+#endif
+	  if (persistent_cache->lookup(this->dirname_, mtime, &this->files_))
+	    return;
+	}
+    }
+
   DIR* d = opendir(this->dirname_);
   if (d == NULL)
     {
@@ -82,6 +327,9 @@ Dir_cache::read_files()
   if (closedir(d) != 0)
     gold::gold_warning("%s: closedir failed: %s", this->dirname_,
 		       strerror(errno));
+
+  if (persistent_cache != NULL && mtime.seconds != 0)
+    persistent_cache->update(this->dirname_, mtime, this->files_);
 }
 
 bool
@@ -91,25 +339,20 @@ Dir_cache::find(const std::string& basename) const
 }
 
 // A mapping from directory names to caches.  A lock permits
-// concurrent update.  There is no lock for read operations--some
-// other mechanism must be used to prevent reads from conflicting with
-// writes.
+// concurrent update and lookup.
 
 class Dir_caches
 {
  public:
-  Dir_caches()
-    : lock_(), caches_()
+  Dir_caches(size_t count)
+    : lock_(), caches_(), remaining_(count)
   { }
 
   ~Dir_caches();
 
-  // Add a cache for a directory.
-  void add(const char*);
-
-  // Look up a directory in the cache.  This much be locked against
-  // calls to Add.
-  Dir_cache* lookup(const char*) const;
+  // Return the cache for a directory, reading the directory if it
+  // has not been read yet.
+  Dir_cache* lookup_or_add(const char*);
 
  private:
   // We can not copy this class.
@@ -120,6 +363,9 @@ class Dir_caches
 
   gold::Lock lock_;
   Cache_hash caches_;
+  // The number of directories which have not been read yet.  When
+  // this drops to zero we write out the persistent cache.
+  size_t remaining_;
 };
 
 Dir_caches::~Dir_caches()
@@ -130,35 +376,44 @@ Dir_caches::~Dir_caches()
     delete p->second;
 }
 
-void
-Dir_caches::add(const char* dirname)
+// We read the directory without holding the lock, so two tasks may
+// read the same directory at the same time.  The first one to finish
+// wins.
+
+Dir_cache*
+Dir_caches::lookup_or_add(const char* dirname)
 {
   {
     gold::Hold_lock hl(this->lock_);
-    if (this->lookup(dirname) != NULL)
-      return;
+    Cache_hash::const_iterator p = this->caches_.find(dirname);
+    if (p != this->caches_.end())
+      return p->second;
   }
 
   Dir_cache* cache = new Dir_cache(dirname);
 
   cache->read_files();
 
+  bool save;
   {
     gold::Hold_lock hl(this->lock_);
 
     std::pair<const char*, Dir_cache*> v(dirname, cache);
     std::pair<Cache_hash::iterator, bool> p = this->caches_.insert(v);
-    gold_assert(p.second);
+    if (!p.second)
+      {
+	delete cache;
+	return p.first->second;
+      }
+    gold_assert(this->remaining_ > 0);
+    --this->remaining_;
+    save = this->remaining_ == 0;
   }
-}
 
-Dir_cache*
-Dir_caches::lookup(const char* dirname) const
-{
-  Cache_hash::const_iterator p = this->caches_.find(dirname);
-  if (p == this->caches_.end())
-    return NULL;
-  return p->second;
+  if (save && persistent_cache != NULL)
+    persistent_cache->save();
+
+  return cache;
 }
 
 // The caches.
@@ -200,8 +455,8 @@ Dir_cache_task::is_runnable()
   return NULL;
 }
 
-// Return the locks to hold.  We use a blocker lock to prevent file
-// lookups from starting until the directory contents have been read.
+// Return the locks to hold.  We use a blocker lock so that the token
+// is released when all the directories have been read.
 
 void
 Dir_cache_task::locks(gold::Task_locker* tl)
@@ -214,7 +469,7 @@ Dir_cache_task::locks(gold::Task_locker* tl)
 void
 Dir_cache_task::run(gold::Workqueue*)
 {
-  caches->add(this->dir_);
+  caches->lookup_or_add(this->dir_);
 }
 
 }
@@ -229,8 +484,16 @@ Dirsearch::initialize(Workqueue* workqueue,
 		      const General_options::Dir_list* directories)
 {
   gold_assert(caches == NULL);
-  caches = new Dir_caches;
+  caches = new Dir_caches(directories->size());
   this->directories_ = directories;
+
+  const char* cache_file = parameters->options().library_path_cache();
+  if (cache_file != NULL && !directories->empty())
+    {
+      persistent_cache = new Persistent_dir_cache(cache_file);
+      persistent_cache->load();
+    }
+
   this->token_.add_blockers(directories->size());
   for (General_options::Dir_list::const_iterator p = directories->begin();
        p != directories->end();
@@ -240,14 +503,16 @@ Dirsearch::initialize(Workqueue* workqueue,
 
 // Search for a file.  NOTE: we only log failed file-lookup attempts
 // here.  Successfully lookups will eventually get logged in
-// File_read::open.
+// File_read::open.  We don't wait for the Dir_cache_tasks: if a
+// directory has not been read yet, we read it here, so a library
+// found early in the search path does not wait for the later
+// directories.
 
 std::string
 Dirsearch::find(const std::vector<std::string>& names,
 		bool* is_in_sysroot, int* pindex,
 		std::string *found_name) const
 {
-  gold_assert(!this->token_.is_blocked());
   gold_assert(*pindex >= 0);
 
   for (unsigned int i = static_cast<unsigned int>(*pindex);
@@ -255,8 +520,7 @@ Dirsearch::find(const std::vector<std::string>& names,
        ++i)
     {
       const Search_directory* p = &this->directories_->at(i);
-      Dir_cache* pdc = caches->lookup(p->name().c_str());
-      gold_assert(pdc != NULL);
+      Dir_cache* pdc = caches->lookup_or_add(p->name().c_str());
       for (std::vector<std::string>::const_iterator n = names.begin();
 	   n != names.end();
 	   ++n)
@@ -51,8 +51,8 @@ class Dirsearch
 
   // Search for a file, giving one or two names to search for (the
   // second one may be empty).  Return a full path name for the file,
-  // or the empty string if it could not be found.  This may only be
-  // called if the token is not blocked.  Set *IS_IN_SYSROOT if the
+  // or the empty string if it could not be found.  Directories which
+  // have not been read yet are read on demand.  Set *IS_IN_SYSROOT if the
   // file was found in a directory which is in the sysroot.  *PINDEX
   // should be set to zero the first time this is called; it will be
   // updated with the index of the directory where the file is found,
@@ -62,7 +62,8 @@ class Dirsearch
   find(const std::vector<std::string>& names, bool* is_in_sysroot,
        int* pindex, std::string *found_name) const;
 
-  // Return the blocker token which controls access.
+  // Return the blocker token, which is released when all the
+  // directories have been read.
   Task_token*
   token()
   { return &this->token_; }
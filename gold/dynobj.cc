@@ -857,7 +857,9 @@ unsigned int
 Dynobj::compute_bucket_count(const std::vector<uint32_t>& hashcodes,
 			     bool for_gnu_hash_table)
 {
-  // FIXME: Implement optional hash table optimization.
+  unsigned int symcount = hashcodes.size();
+  if (parameters->options().optimize() >= 1 && symcount > 1)
+    return Dynobj::optimized_bucket_count(hashcodes, for_gnu_hash_table);
 
   // Array used to determine the number of hash table buckets to use
   // based on the number of symbols there are.  If there are fewer
@@ -872,7 +874,6 @@ Dynobj::compute_bucket_count(const std::vector<uint32_t>& hashcodes,
   };
   const int buckets_count = sizeof buckets / sizeof buckets[0];
 
-  unsigned int symcount = hashcodes.size();
   unsigned int ret = 1;
   const double full_fraction
     = 1.0 - parameters->options().hash_bucket_empty_fraction();
@@ -889,6 +890,180 @@ Dynobj::compute_bucket_count(const std::vector<uint32_t>& hashcodes,
   return ret;
 }
 
+// Search for the number of hash buckets which minimizes the length of
+// the hash chains, with a penalty for the overall size of the table.
+// The cost function is the one used by the old GNU linker, but that
+// linker tried every size between SYMCOUNT/4 and SYMCOUNT*2, which is
+// quadratic in the number of symbols.  We instead probe a fixed number
+// of sizes spread over that range, and then probe the neighborhood of
+// the best one more closely, which keeps the search linear.
+
+unsigned int
+Dynobj::optimized_bucket_count(const std::vector<uint32_t>& hashcodes,
+			       bool for_gnu_hash_table)
+{
+  // The number of sizes we try in each of the two passes.
+  const unsigned int probe_count = 64;
+
+  const unsigned int symcount = hashcodes.size();
+  unsigned int minsize = symcount / 4;
+  if (minsize < (for_gnu_hash_table ? 2U : 1U))
+    minsize = for_gnu_hash_table ? 2 : 1;
+  const unsigned int maxsize = symcount * 2;
+
+  std::vector<uint32_t> counts(maxsize);
+  unsigned int best_size = 0;
+  uint64_t best_cost = 0;
+
+  unsigned int step = (maxsize - minsize) / probe_count;
+  if (step == 0)
+    step = 1;
+  unsigned int lo = minsize;
+  unsigned int hi = maxsize;
+  while (true)
+    {
+      for (unsigned int i = lo; i < hi; i += step)
+	{
+	  // A GNU hash table with a multiple of 32 buckets would use the
+	  // same hash bits for the bucket and for the bloom filter, so
+	  // try the next size instead, as the old GNU linker does.
+	  unsigned int size = i;
+	  if (for_gnu_hash_table && (size & 31) == 0)
+	    ++size;
+	  if (size > maxsize)
+	    break;
+	  uint64_t cost = Dynobj::bucket_count_cost(hashcodes, size, &counts);
+	  if (best_size == 0 || cost < best_cost)
+	    {
+	      best_cost = cost;
+	      best_size = size;
+	    }
+	}
+
+      if (step == 1 || best_size == 0)
+	break;
+
+      // Look more closely around the best size found so far.
+      lo = best_size > minsize + step ? best_size - step : minsize;
+      hi = best_size + step < maxsize ? best_size + step : maxsize;
+      if (hi <= lo)
+	break;
+      step = (hi - lo) / probe_count;
+      if (step == 0)
+	step = 1;
+    }
+
+  if (best_size == 0)
+    best_size = minsize;
+  return best_size;
+}
+
+// Return the cost of a hash table with BUCKETCOUNT buckets for the
+// hash codes in HASHCODES.  COUNTS is scratch space with room for at
+// least BUCKETCOUNT entries.  We add the squares of all the chain
+// lengths, which favors many short chains over a few long ones, and
+// then scale by the square of the number of pages the table needs.
+
+uint64_t
+Dynobj::bucket_count_cost(const std::vector<uint32_t>& hashcodes,
+			  unsigned int bucketcount,
+			  std::vector<uint32_t>* counts)
+{
+  // This need not be accurate; it only weighs the table size.
+  const uint64_t pagesize = 4096;
+  const uint64_t entsize = 4;
+
+  const unsigned int symcount = hashcodes.size();
+  uint32_t* pcounts = &(*counts)[0];
+  memset(pcounts, 0, bucketcount * sizeof(uint32_t));
+  for (unsigned int i = 0; i < symcount; ++i)
+    ++pcounts[hashcodes[i] % bucketcount];
+
+  uint64_t cost = (2 + symcount) * entsize;
+  for (unsigned int i = 0; i < bucketcount; ++i)
+    cost += static_cast<uint64_t>(pcounts[i]) * pcounts[i];
+
+  uint64_t fact = bucketcount / (pagesize / entsize) + 1;
+  return cost * fact * fact;
+}
+
+// Choose the size and the second shift count of the bloom filter of a
+// GNU hash table.  The dynamic linker checks the bloom filter before
+// looking at the buckets, so a filter with fewer false positives makes
+// looking up a symbol which is not defined in this object cheaper.
+// HASHCODES are the hash codes of the symbols in the table.  SHIFT1 is
+// the log2 of the number of bits in a bloom filter word.
+// *PMASKBITSLOG2 is the log2 of the default filter size in bits, and
+// is updated along with *PSHIFT2.
+//
+// For a symbol which is not in the table the probability of a false
+// positive is the chance that both of its bits are set in the word it
+// selects, which we measure from the actual filter contents.  We try
+// every second shift for the default size and for up to four times
+// that size.  Since a larger filter takes more cache, we only accept
+// doubling its size if that at least halves the false positive rate.
+
+void
+Dynobj::optimize_gnu_hash_bloom(const std::vector<uint32_t>& hashcodes,
+				uint32_t shift1, uint32_t* pmaskbitslog2,
+				uint32_t* pshift2)
+{
+  const unsigned int symcount = hashcodes.size();
+  const uint32_t wordbits = 1U << shift1;
+  const uint32_t mask = wordbits - 1;
+
+  uint32_t best_maskbitslog2 = *pmaskbitslog2;
+  uint32_t best_shift2 = *pshift2;
+  double best_rate = 0;
+
+  std::vector<uint64_t> bitmask;
+  for (uint32_t maskbitslog2 = *pmaskbitslog2;
+       maskbitslog2 <= *pmaskbitslog2 + 2 && maskbitslog2 < 32;
+       ++maskbitslog2)
+    {
+      const uint32_t maskwords = 1U << (maskbitslog2 - shift1);
+      double size_best_rate = 0;
+      uint32_t size_best_shift2 = 0;
+      for (uint32_t shift2 = shift1; shift2 < 32; ++shift2)
+	{
+	  bitmask.assign(maskwords, 0);
+	  for (unsigned int i = 0; i < symcount; ++i)
+	    {
+	      uint32_t hashval = hashcodes[i];
+	      uint64_t& word(bitmask[(hashval >> shift1) & (maskwords - 1)]);
+	      word |= static_cast<uint64_t>(1) << (hashval & mask);
+	      word |= static_cast<uint64_t>(1) << ((hashval >> shift2) & mask);
+	    }
+
+	  double rate = 0;
+	  for (uint32_t i = 0; i < maskwords; ++i)
+	    {
+	      unsigned int bits = 0;
+	      for (uint64_t w = bitmask[i]; w != 0; w &= w - 1)
+		++bits;
+	      double fraction = static_cast<double>(bits) / wordbits;
+	      rate += fraction * fraction;
+	    }
+	  rate /= maskwords;
+
+	  if (shift2 == shift1 || rate < size_best_rate)
+	    {
+	      size_best_rate = rate;
+	      size_best_shift2 = shift2;
+	    }
+	}
+
+      if (maskbitslog2 != *pmaskbitslog2 && size_best_rate * 2 > best_rate)
+	break;
+      best_rate = size_best_rate;
+      best_maskbitslog2 = maskbitslog2;
+      best_shift2 = size_best_shift2;
+    }
+
+  *pmaskbitslog2 = best_maskbitslog2;
+  *pshift2 = best_shift2;
+}
+
 // The standard ELF hash function.  This hash function must not
 // change, as the dynamic linker uses it also.
 
@@ -1209,6 +1384,9 @@ Dynobj::sized_create_gnu_hash_table(
     }
   uint32_t mask = (1U << shift1) - 1U;
   uint32_t shift2 = maskbitslog2;
+  if (parameters->options().hash_bloom_optimize())
+    Dynobj::optimize_gnu_hash_bloom(dynsym_hashvals, shift1, &maskbitslog2,
+				    &shift2);
   uint32_t maskbits = 1U << maskbitslog2;
   uint32_t maskwords = 1U << (maskbitslog2 - shift1);
 
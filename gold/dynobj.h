@@ -131,6 +131,24 @@ class Dynobj : public Object
   compute_bucket_count(const std::vector<uint32_t>& hashcodes,
 		       bool for_gnu_hash_table);
 
+  // Search for the number of hash buckets which gives the shortest
+  // chains, used when optimizing.
+  static unsigned int
+  optimized_bucket_count(const std::vector<uint32_t>& hashcodes,
+			 bool for_gnu_hash_table);
+
+  // Return the cost of a hash table with BUCKETCOUNT buckets.
+  static uint64_t
+  bucket_count_cost(const std::vector<uint32_t>& hashcodes,
+		    unsigned int bucketcount,
+		    std::vector<uint32_t>* counts);
+
+  // Choose the size and second shift of the GNU hash bloom filter.
+  static void
+  optimize_gnu_hash_bloom(const std::vector<uint32_t>& hashcodes,
+			  uint32_t shift1, uint32_t* pmaskbitslog2,
+			  uint32_t* pshift2);
+
   // Sized version of create_elf_hash_table.
   template<bool big_endian>
   static void
@@ -124,6 +124,15 @@ static Initialize_lock file_counts_initialize_lock(&file_counts_lock);
 unsigned long long File_read::total_mapped_bytes;
 unsigned long long File_read::current_mapped_bytes;
 unsigned long long File_read::maximum_mapped_bytes;
+unsigned long long File_read::prefetched_files;
+unsigned long long File_read::prefetched_bytes;
+unsigned long long File_read::prefetch_hits;
+unsigned long long File_read::prefetch_misses;
+
+// The names of the files passed to File_read::prefetch, so that we can
+// tell whether a file we open was prefetched.  This is protected by
+// file_counts_lock.
+static Unordered_set<std::string>* prefetched_names;
 
 // Class File_read::View.
 
@@ -211,11 +220,75 @@ File_read::open(const Task* task, const std::string& name)
       gold_debug(DEBUG_FILES, "Attempt to open %s succeeded",
 		 this->name_.c_str());
       this->token_.add_writer(task);
+
+      if (parameters->options_valid()
+	  && parameters->options().prefetch_inputs()
+	  && parameters->options().stats())
+	{
+	  file_counts_initialize_lock.initialize();
+	  Hold_optional_lock hl(file_counts_lock);
+	  if (prefetched_names != NULL
+	      && prefetched_names->find(this->name_) != prefetched_names->end())
+	    ++File_read::prefetch_hits;
+	  else
+	    ++File_read::prefetch_misses;
+	}
     }
 
   return this->descriptor_ >= 0;
 }
 
+// Ask the system to start reading the file NAME, which we expect to
+// open soon.  We only start the I/O here; we don't wait for it.  The
+// headers of an object file are at the start and the section headers
+// and symbol table are usually at the end, so we ask for the whole
+// file, but never more than LIMIT bytes.  This uses a plain
+// descriptor rather than open_descriptor, since we close it right
+// away.
+
+off_t
+File_read::prefetch(const std::string& name, off_t limit)
+{
+#ifdef HAVE_POSIX_FADVISE
+  if (limit <= 0)
+    return 0;
+
+  int o = ::open(name.c_str(), O_RDONLY);
+  if (o < 0)
+    return 0;
+
+  off_t len = 0;
+  struct stat s;
+  if (::fstat(o, &s) == 0 && S_ISREG(s.st_mode))
+    {
+      len = s.st_size < limit ? s.st_size : limit;
+      if (::posix_fadvise(o, 0, len, POSIX_FADV_WILLNEED) != 0)
+	len = 0;
+    }
+  ::close(o);
+
+  if (len > 0)
+    {
+      gold_debug(DEBUG_FILES, "Prefetching %lld bytes of %s",
+		 static_cast<long long>(len), name.c_str());
+      if (parameters->options().stats())
+	{
+	  file_counts_initialize_lock.initialize();
+	  Hold_optional_lock hl(file_counts_lock);
+	  if (prefetched_names == NULL)
+	    prefetched_names = new Unordered_set<std::string>();
+	  prefetched_names->insert(name);
+	  ++File_read::prefetched_files;
+	  File_read::prefetched_bytes += len;
+	}
+    }
+
+  return len;
+#else
+  return 0;
+#endif
+}
+
 // Open the file with the contents in memory.
 
 bool
@@ -675,15 +748,51 @@ File_read::do_readv(off_t base, const Read_multiple& rm, size_t start,
 
   gold_assert(iov_index < sizeof iov / sizeof iov[0]);
 
+#ifndef HAVE_PREADV
   if (::lseek(this->descriptor_, base + first_offset, SEEK_SET) < 0)
     gold_fatal(_("%s: lseek failed: %s"),
 	       this->filename().c_str(), strerror(errno));
+#endif
+
+  // A short read can happen for a large request, so keep reading
+  // until we have everything or hit end of file.
+  iovec* piov = iov;
+  int niov = iov_index;
+  ssize_t got = 0;
+  while (got < want)
+    {
+#ifdef HAVE_PREADV
+      ssize_t bytes = ::preadv(this->descriptor_, piov, niov,
+			       base + first_offset + got);
+#else
+      ssize_t bytes = ::readv(this->descriptor_, piov, niov);
+#endif
+      if (bytes < 0)
+	{
+	  if (errno == EINTR)
+	    continue;
+	  gold_fatal(_("%s: readv failed: %s"),
+		     this->filename().c_str(), strerror(errno));
+	}
+      if (bytes == 0)
+	break;
+      got += bytes;
 
-  ssize_t got = ::readv(this->descriptor_, iov, iov_index);
+      // Skip the iovecs we have filled, and adjust a partially
+      // filled one.
+      while (niov > 0 && static_cast<size_t>(bytes) >= piov->iov_len)
+	{
+	  bytes -= piov->iov_len;
+	  ++piov;
+	  --niov;
+	}
+      if (bytes > 0)
+	{
+	  piov->iov_base = static_cast<char*>(piov->iov_base) + bytes;
+	  piov->iov_len -= bytes;
+	}
+    }
 
-  if (got < 0)
-    gold_fatal(_("%s: readv failed: %s"),
-	       this->filename().c_str(), strerror(errno));
   if (got != want)
     gold_fatal(_("%s: file too short: read only %zd of %zd bytes at %lld"),
 	       this->filename().c_str(),
@@ -707,11 +816,22 @@ File_read::read_multiple(off_t base, const Read_multiple& rm)
 {
   static size_t iov_max = GOLD_IOV_MAX;
   size_t count = rm.size();
+
+  // First split the entries into groups of up to MAX_READV_ENTRIES
+  // consecutive entries which are less than one page apart.  For
+  // each group we remember the end index, the end offset, and the
+  // view which already covers it, if any.
+  struct Group
+  {
+    size_t end;
+    off_t end_off;
+    File_read::View* view;
+  };
+  std::vector<Group> groups;
+  size_t disk_groups = 0;
   size_t i = 0;
   while (i < count)
     {
-      // Find up to MAX_READV_ENTRIES consecutive entries which are
-      // less than one page apart.
       const Read_multiple_entry& i_entry(rm[i]);
       off_t i_off = i_entry.file_offset;
       off_t end_off = i_off + i_entry.size;
@@ -729,32 +849,74 @@ File_read::read_multiple(off_t base, const Read_multiple& rm)
 	  end_off = j_end_off;
 	}
 
+      Group g;
+      g.end = j;
+      g.end_off = end_off;
+      g.view = NULL;
+      if (j > i + 1)
+	{
+	  g.view = this->find_view(base + i_off, end_off - i_off, -1U, NULL);
+	  if (g.view == NULL)
+	    ++disk_groups;
+	}
+      groups.push_back(g);
+
+      i = j;
+    }
+
+#ifdef HAVE_POSIX_FADVISE
+  // If we are going to issue more than one readv, tell the kernel
+  // about all of them up front, so that it can start reading the
+  // later ranges while we wait for the first one.
+  if (disk_groups > 1 && this->whole_file_view_ == NULL)
+    {
+      this->reopen_descriptor();
+      i = 0;
+      for (std::vector<Group>::const_iterator p = groups.begin();
+	   p != groups.end();
+	   ++p)
+	{
+	  if (p->end > i + 1 && p->view == NULL)
+	    {
+	      off_t off = base + rm[i].file_offset;
+	      ::posix_fadvise(this->descriptor_, off, base + p->end_off - off,
+			      POSIX_FADV_WILLNEED);
+	    }
+	  i = p->end;
+	}
+    }
+#endif
+
+  i = 0;
+  for (std::vector<Group>::const_iterator p = groups.begin();
+       p != groups.end();
+       ++p)
+    {
+      const Read_multiple_entry& i_entry(rm[i]);
+      off_t i_off = i_entry.file_offset;
+      size_t j = p->end;
+      off_t end_off = p->end_off;
+
       if (j == i + 1)
 	this->read(base + i_off, i_entry.size, i_entry.buffer);
+      else if (p->view == NULL)
+	this->do_readv(base, rm, i, j - i);
       else
 	{
-	  File_read::View* view = this->find_view(base + i_off,
-						  end_off - i_off,
-						  -1U, NULL);
-	  if (view == NULL)
-	    this->do_readv(base, rm, i, j - i);
-	  else
+	  File_read::View* view = p->view;
+	  const unsigned char* v = (view->data()
+				    + (base + i_off - view->start()
+				       + view->byteshift()));
+	  for (size_t k = i; k < j; ++k)
 	    {
-	      const unsigned char* v = (view->data()
-					+ (base + i_off - view->start()
-					   + view->byteshift()));
-	      for (size_t k = i; k < j; ++k)
-		{
-		  const Read_multiple_entry& k_entry(rm[k]);
-		  gold_assert((convert_to_section_size_type(k_entry.file_offset
-							   - i_off)
-			       + k_entry.size)
-			      <= convert_to_section_size_type(end_off
-							      - i_off));
-		  memcpy(k_entry.buffer,
-			 v + (k_entry.file_offset - i_off),
-			 k_entry.size);
-		}
+	      const Read_multiple_entry& k_entry(rm[k]);
+	      gold_assert((convert_to_section_size_type(k_entry.file_offset
+						       - i_off)
+			   + k_entry.size)
+			  <= convert_to_section_size_type(end_off - i_off));
+	      memcpy(k_entry.buffer,
+		     v + (k_entry.file_offset - i_off),
+		     k_entry.size);
 	    }
 	}
 
@@ -856,6 +1018,16 @@ File_read::print_stats()
 	  program_name, File_read::total_mapped_bytes);
   fprintf(stderr, _("%s: maximum bytes mapped for read at one time: %llu\n"),
 	  program_name, File_read::maximum_mapped_bytes);
+  if (parameters->options_valid() && parameters->options().prefetch_inputs())
+    {
+      fprintf(stderr, _("%s: input files prefetched: %llu (%llu bytes)\n"),
+	      program_name, File_read::prefetched_files,
+	      File_read::prefetched_bytes);
+      fprintf(stderr, _("%s: input files opened after prefetch: %llu; "
+			"without prefetch: %llu\n"),
+	      program_name, File_read::prefetch_hits,
+	      File_read::prefetch_misses);
+    }
 }
 
 // Class File_view.
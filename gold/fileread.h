@@ -207,6 +207,12 @@ class File_read
   static void
   print_stats();
 
+  // Ask the system to start reading up to LIMIT bytes of the file
+  // NAME into memory, so that it is ready when we open it later.
+  // Returns the number of bytes requested.
+  static off_t
+  prefetch(const std::string& name, off_t limit);
+
   // Return the open file descriptor (for plugins).
   int
   descriptor()
@@ -247,6 +253,18 @@ class File_read
   // --stats.
   static unsigned long long maximum_mapped_bytes;
 
+  // Number of files passed to prefetch.
+  static unsigned long long prefetched_files;
+
+  // Total bytes requested by prefetch.
+  static unsigned long long prefetched_bytes;
+
+  // Number of files opened after having been passed to prefetch.
+  static unsigned long long prefetch_hits;
+
+  // Number of files opened which were not passed to prefetch.
+  static unsigned long long prefetch_misses;
+
   // A view into the file.
   class View
   {
@@ -408,7 +426,7 @@ class File_read
   // The maximum number of entries we will pass to ::readv.
   static const size_t max_readv_entries = 128;
 
-  // Use readv to read data.
+  // Use preadv (or readv) to read data.
   void
   do_readv(off_t base, const Read_multiple&, size_t start, size_t count);
 
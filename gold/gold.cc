@@ -230,6 +230,9 @@ queue_initial_tasks(const General_options& options,
   Task_token* this_blocker = NULL;
   if (ibase == NULL)
     {
+      if (options.prefetch_inputs())
+	workqueue->queue(new Prefetch_inputs(cmdline.begin(), cmdline.end()));
+
       // Normal link.  Queue a Read_symbols task for each input file
       // on the command line.
       for (Command_line::const_iterator p = cmdline.begin();
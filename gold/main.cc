@@ -313,7 +313,8 @@ main(int argc, char** argv)
   // Output cross reference table.
   if (command_line.options().cref())
     input_objects.print_cref(&symtab,
-			     mapfile == NULL ? stdout : mapfile->file());
+			     mapfile == NULL ? stdout : mapfile->file(),
+			     mapfile != NULL && mapfile->is_json());
 
   if (mapfile != NULL)
     mapfile->close();
@@ -22,6 +22,7 @@
 
 #include "gold.h"
 
+#include <algorithm>
 #include <cerrno>
 #include <cstdio>
 #include <cstring>
@@ -33,6 +34,8 @@
 
 // This file holds the code for printing information to the map file.
 // In general we try to produce pretty much the same format as GNU ld.
+// With --map-format=json we instead write one JSON object per line,
+// each with a "type" field, which is simpler for programs to read.
 
 namespace gold
 {
@@ -41,6 +44,8 @@ namespace gold
 
 Mapfile::Mapfile()
   : map_file_(NULL),
+    is_json_(false),
+    section_symbols_(),
     printed_archive_header_(false),
     printed_common_header_(false),
     printed_memory_map_header_(false)
@@ -53,6 +58,10 @@ Mapfile::~Mapfile()
 {
   if (this->map_file_ != NULL)
     this->close();
+  for (Section_symbols_map::iterator p = this->section_symbols_.begin();
+       p != this->section_symbols_.end();
+       ++p)
+    delete p->second;
 }
 
 // Open the map file.
@@ -71,7 +80,11 @@ Mapfile::open(const char* map_filename)
 		     strerror(errno));
 	  return false;
 	}
+      // The map file for a large link can be big, so use a larger
+      // buffer than the default.
+      setvbuf(this->map_file_, NULL, _IOFBF, 64 * 1024);
     }
+  this->is_json_ = strcmp(parameters->options().map_format(), "json") == 0;
   return true;
 }
 
@@ -85,6 +98,28 @@ Mapfile::close()
   this->map_file_ = NULL;
 }
 
+// Print a quoted JSON string.
+
+void
+Mapfile::print_json_string(FILE* f, const char* s)
+{
+  putc('"', f);
+  for (; *s != '\0'; ++s)
+    {
+      unsigned char c = *s;
+      if (c == '"' || c == '\\')
+	{
+	  putc('\\', f);
+	  putc(c, f);
+	}
+      else if (c < 0x20)
+	fprintf(f, "\\u%04x", c);
+      else
+	putc(c, f);
+    }
+  putc('"', f);
+}
+
 // Advance to a column.
 
 void
@@ -108,6 +143,30 @@ void
 Mapfile::report_include_archive_member(const std::string& member_name,
 				       const Symbol* sym, const char* why)
 {
+  if (this->is_json_)
+    {
+      FILE* f = this->map_file_;
+      fprintf(f, "{\"type\":\"archive_member\",\"member\":");
+      Mapfile::print_json_string(f, member_name.c_str());
+      if (sym == NULL)
+	{
+	  fprintf(f, ",\"reason\":");
+	  Mapfile::print_json_string(f, why);
+	}
+      else
+	{
+	  if (sym->source() == Symbol::FROM_OBJECT)
+	    {
+	      fprintf(f, ",\"file\":");
+	      Mapfile::print_json_string(f, sym->object()->name().c_str());
+	    }
+	  fprintf(f, ",\"symbol\":");
+	  Mapfile::print_json_string(f, sym->name());
+	}
+      fprintf(f, "}\n");
+      return;
+    }
+
   // We print a header before the list of archive members, mainly for
   // GNU ld compatibility.
   if (!this->printed_archive_header_)
@@ -154,6 +213,18 @@ Mapfile::report_include_archive_member(const std::string& member_name,
 void
 Mapfile::report_allocate_common(const Symbol* sym, uint64_t symsize)
 {
+  if (this->is_json_)
+    {
+      FILE* f = this->map_file_;
+      fprintf(f, "{\"type\":\"common\",\"symbol\":");
+      Mapfile::print_json_string(f, sym->demangled_name().c_str());
+      fprintf(f, ",\"size\":%llu,\"file\":",
+	      static_cast<unsigned long long>(symsize));
+      Mapfile::print_json_string(f, sym->object()->name().c_str());
+      fprintf(f, "}\n");
+      return;
+    }
+
   if (!this->printed_common_header_)
     {
       fprintf(this->map_file_, _("\nAllocating common symbols\n"));
@@ -190,43 +261,80 @@ const size_t Mapfile::section_name_map_length = 16;
 void
 Mapfile::print_memory_map_header()
 {
-  if (!this->printed_memory_map_header_)
+  if (!this->printed_memory_map_header_ && !this->is_json_)
     {
       fprintf(this->map_file_, _("\nMemory map\n\n"));
       this->printed_memory_map_header_ = true;
     }
 }
 
-// Print the symbols associated with an input section.
+// Return the global symbols which RELOBJ defines in its ordinary
+// sections, sorted by section index and then by symbol index.  We
+// build this the first time we need it for an object, so that
+// printing each input section does not have to walk all the symbols
+// of its object.
 
 template<int size, bool big_endian>
-void
-Mapfile::print_input_section_symbols(
-    const Sized_relobj_file<size, big_endian>* relobj,
-    unsigned int shndx)
+const Mapfile::Section_symbols*
+Mapfile::section_symbols(const Sized_relobj_file<size, big_endian>* relobj)
 {
+  std::pair<Section_symbols_map::iterator, bool> ins =
+    this->section_symbols_.insert(std::make_pair(relobj,
+						 static_cast<Section_symbols*>(NULL)));
+  if (!ins.second)
+    return ins.first->second;
+
+  Section_symbols* ss = new Section_symbols();
   unsigned int symcount = relobj->symbol_count();
   for (unsigned int i = relobj->local_symbol_count(); i < symcount; ++i)
     {
       const Symbol* sym = relobj->global_symbol(i);
       bool is_ordinary;
+      unsigned int shndx;
       if (sym != NULL
 	  && sym->source() == Symbol::FROM_OBJECT
 	  && sym->object() == relobj
-	  && sym->shndx(&is_ordinary) == shndx
-	  && is_ordinary
+	  && (shndx = sym->shndx(&is_ordinary), is_ordinary)
 	  && sym->is_defined())
+	ss->push_back(std::make_pair(shndx, i));
+    }
+  std::sort(ss->begin(), ss->end());
+
+  ins.first->second = ss;
+  return ss;
+}
+
+// Print the symbols associated with an input section.
+
+template<int size, bool big_endian>
+void
+Mapfile::print_input_section_symbols(
+    const Sized_relobj_file<size, big_endian>* relobj,
+    unsigned int shndx)
+{
+  const Section_symbols* ss = this->section_symbols(relobj);
+  Section_symbols::const_iterator p =
+    std::lower_bound(ss->begin(), ss->end(), std::make_pair(shndx, 0U));
+  for (; p != ss->end() && p->first == shndx; ++p)
+    {
+      const Sized_symbol<size>* ssym =
+	static_cast<const Sized_symbol<size>*>(relobj->global_symbol(p->second));
+      if (this->is_json_)
 	{
-	  for (size_t i = 0; i < Mapfile::section_name_map_length; ++i)
-	    putc(' ', this->map_file_);
-	  const Sized_symbol<size>* ssym =
-	    static_cast<const Sized_symbol<size>*>(sym);
-	  fprintf(this->map_file_,
-		  "0x%0*llx                %s\n",
-		  size / 4,
-		  static_cast<unsigned long long>(ssym->value()),
-		  sym->demangled_name().c_str());
+	  fprintf(this->map_file_, "{\"type\":\"symbol\",\"name\":");
+	  Mapfile::print_json_string(this->map_file_,
+				     ssym->demangled_name().c_str());
+	  fprintf(this->map_file_, ",\"value\":%llu}\n",
+		  static_cast<unsigned long long>(ssym->value()));
+	  continue;
 	}
+      for (size_t i = 0; i < Mapfile::section_name_map_length; ++i)
+	putc(' ', this->map_file_);
+      fprintf(this->map_file_,
+	      "0x%0*llx                %s\n",
+	      size / 4,
+	      static_cast<unsigned long long>(ssym->value()),
+	      ssym->demangled_name().c_str());
     }
 }
 
@@ -235,12 +343,15 @@ Mapfile::print_input_section_symbols(
 void
 Mapfile::print_input_section(Relobj* relobj, unsigned int shndx)
 {
-  putc(' ', this->map_file_);
-
   std::string name = relobj->section_name(shndx);
-  fprintf(this->map_file_, "%s", name.c_str());
 
-  this->advance_to_column(name.length() + 1, Mapfile::section_name_map_length);
+  if (!this->is_json_)
+    {
+      putc(' ', this->map_file_);
+      fprintf(this->map_file_, "%s", name.c_str());
+      this->advance_to_column(name.length() + 1,
+			      Mapfile::section_name_map_length);
+    }
 
   Output_section* os;
   uint64_t addr;
@@ -264,10 +375,24 @@ Mapfile::print_input_section(Relobj* relobj, unsigned int shndx)
   snprintf(sizebuf, sizeof sizebuf, "0x%llx",
 	   static_cast<unsigned long long>(size));
 
-  fprintf(this->map_file_, "0x%0*llx %10s %s\n",
-	  parameters->target().get_size() / 4,
-	  static_cast<unsigned long long>(addr), sizebuf,
-	  relobj->name().c_str());
+  if (this->is_json_)
+    {
+      FILE* f = this->map_file_;
+      fprintf(f, "{\"type\":\"%s\",\"name\":",
+	      os != NULL ? "input_section" : "discarded_section");
+      Mapfile::print_json_string(f, name.c_str());
+      if (os != NULL && addr != -1ULL)
+	fprintf(f, ",\"address\":%llu", static_cast<unsigned long long>(addr));
+      fprintf(f, ",\"size\":%llu,\"file\":",
+	      static_cast<unsigned long long>(size));
+      Mapfile::print_json_string(f, relobj->name().c_str());
+      fprintf(f, "}\n");
+    }
+  else
+    fprintf(this->map_file_, "0x%0*llx %10s %s\n",
+	    parameters->target().get_size() / 4,
+	    static_cast<unsigned long long>(addr), sizebuf,
+	    relobj->name().c_str());
 
   if (os != NULL)
     {
@@ -323,6 +448,18 @@ Mapfile::print_output_data(const Output_data* od, const char* name)
 {
   this->print_memory_map_header();
 
+  if (this->is_json_)
+    {
+      fprintf(this->map_file_, "{\"type\":\"output_data\",\"name\":");
+      Mapfile::print_json_string(this->map_file_, name);
+      if (od->is_address_valid())
+	fprintf(this->map_file_, ",\"address\":%llu",
+		static_cast<unsigned long long>(od->address()));
+      fprintf(this->map_file_, ",\"size\":%llu}\n",
+	      static_cast<unsigned long long>(od->current_data_size()));
+      return;
+    }
+
   putc(' ', this->map_file_);
 
   fprintf(this->map_file_, "%s", name);
@@ -367,7 +504,7 @@ Mapfile::print_discarded_sections(const Input_objects* input_objects)
 	       || sh_type == elfcpp::SHT_GROUP)
 	      && !relobj->is_section_included(i))
 	    {
-	      if (!printed_header)
+	      if (!printed_header && !this->is_json_)
 		{
 		  fprintf(this->map_file_, _("\nDiscarded input sections\n\n"));
 		  printed_header = true;
@@ -386,6 +523,23 @@ Mapfile::print_output_section(const Output_section* os)
 {
   this->print_memory_map_header();
 
+  if (this->is_json_)
+    {
+      FILE* f = this->map_file_;
+      fprintf(f, "{\"type\":\"output_section\",\"name\":");
+      Mapfile::print_json_string(f, os->name());
+      fprintf(f, ",\"address\":%llu,\"size\":%llu",
+	      static_cast<unsigned long long>(os->address()),
+	      static_cast<unsigned long long>(os->current_data_size()));
+      if (os->has_load_address())
+	fprintf(f, ",\"load_address\":%llu",
+		static_cast<unsigned long long>(os->load_address()));
+      if (os->requires_postprocessing())
+	fprintf(f, ",\"before_compression\":true");
+      fprintf(f, "}\n");
+      return;
+    }
+
   fprintf(this->map_file_, "\n%s", os->name());
 
   this->advance_to_column(strlen(os->name()), Mapfile::section_name_map_length);
@@ -25,6 +25,8 @@
 
 #include <cstdio>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace gold
 {
@@ -59,6 +61,15 @@ class Mapfile
   file()
   { return this->map_file_; }
 
+  // Return whether we are writing the map file as JSON.
+  bool
+  is_json() const
+  { return this->is_json_; }
+
+  // Print S to F as a quoted JSON string.
+  static void
+  print_json_string(FILE* f, const char* s);
+
   // Report that we are including a member from an archive.  This is
   // called by the archive reading code.
   void
@@ -103,8 +114,23 @@ class Mapfile
   print_input_section_symbols(const Sized_relobj_file<size, big_endian>*,
 			      unsigned int shndx);
 
+  // A list of (section index, global symbol index) pairs, sorted.
+  typedef std::vector<std::pair<unsigned int, unsigned int> > Section_symbols;
+
+  // Return the global symbols defined in each section of an object.
+  template<int size, bool big_endian>
+  const Section_symbols*
+  section_symbols(const Sized_relobj_file<size, big_endian>*);
+
+  // Map from objects to the symbols they define, built on demand.
+  typedef Unordered_map<const Relobj*, Section_symbols*> Section_symbols_map;
+
   // Map file to write to.
   FILE* map_file_;
+  // Whether to write JSON rather than text.
+  bool is_json_;
+  // The symbols defined by each object, for print_input_section.
+  Section_symbols_map section_symbols_;
   // Whether we have printed the archive member header.
   bool printed_archive_header_;
   // Whether we have printed the allocated common header.
@@ -257,7 +257,30 @@ Output_merge_base::record_input_section(Relobj* relobj, unsigned int shndx)
 
 // Class Output_merge_data.
 
-// Compute the hash code for a fixed-size constant.
+// Mix the bits of a 64-bit word for use as a hash code.
+
+static inline uint64_t
+merge_data_mix(uint64_t v)
+{
+  v ^= v >> 33;
+  v *= 0xff51afd7ed558ccdULL;
+  v ^= v >> 33;
+  return v;
+}
+
+// Load an unaligned 64-bit word.
+
+static inline uint64_t
+merge_data_word(const unsigned char* p)
+{
+  uint64_t v;
+  memcpy(&v, p, sizeof v);
+  return v;
+}
+
+// Compute the hash code for a fixed-size constant.  Most merged
+// constants are 4, 8, 16 or 32 bytes long, so we handle those sizes
+// a word at a time.
 
 size_t
 Output_merge_data::Merge_data_hash::operator()(Merge_data_key k) const
@@ -266,13 +289,37 @@ Output_merge_data::Merge_data_hash::operator()(Merge_data_key k) const
   section_size_type entsize =
     convert_to_section_size_type(this->pomd_->entsize());
 
+  switch (entsize)
+    {
+    case 4:
+      {
+	uint32_t v;
+	memcpy(&v, p, sizeof v);
+	return merge_data_mix(v);
+      }
+    case 8:
+      return merge_data_mix(merge_data_word(p));
+    case 16:
+      return merge_data_mix(merge_data_word(p)
+			    ^ merge_data_mix(merge_data_word(p + 8)));
+    case 32:
+      return merge_data_mix(merge_data_word(p)
+			    ^ merge_data_mix(merge_data_word(p + 8)
+					     ^ merge_data_mix(
+						 merge_data_word(p + 16)
+						 ^ merge_data_mix(
+						     merge_data_word(p + 24)))));
+    default:
+      break;
+    }
+
   // Fowler/Noll/Vo (FNV) hash (type FNV-1a).
   if (sizeof(size_t) == 8)
     {
       size_t result = static_cast<size_t>(14695981039346656037ULL);
       for (section_size_type i = 0; i < entsize; ++i)
 	{
-	  result &= (size_t) *p++;
+	  result ^= (size_t) *p++;
 	  result *= 1099511628211ULL;
 	}
       return result;
@@ -289,7 +336,9 @@ Output_merge_data::Merge_data_hash::operator()(Merge_data_key k) const
     }
 }
 
-// Return whether one hash table key equals another.
+// Return whether one hash table key equals another.  Passing a
+// constant size to memcmp lets the compiler compare the common sizes
+// inline.
 
 bool
 Output_merge_data::Merge_data_eq::operator()(Merge_data_key k1,
@@ -297,7 +346,19 @@ Output_merge_data::Merge_data_eq::operator()(Merge_data_key k1,
 {
   const unsigned char* p1 = this->pomd_->constant(k1);
   const unsigned char* p2 = this->pomd_->constant(k2);
-  return memcmp(p1, p2, this->pomd_->entsize()) == 0;
+  switch (this->pomd_->entsize())
+    {
+    case 4:
+      return memcmp(p1, p2, 4) == 0;
+    case 8:
+      return memcmp(p1, p2, 8) == 0;
+    case 16:
+      return memcmp(p1, p2, 16) == 0;
+    case 32:
+      return memcmp(p1, p2, 32) == 0;
+    default:
+      return memcmp(p1, p2, this->pomd_->entsize()) == 0;
+    }
 }
 
 // Add a constant to the end of the section contents.
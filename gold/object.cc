@@ -3078,10 +3078,11 @@ Input_objects::print_symbol_counts(const Symbol_table* symtab) const
 // Print a cross reference table.
 
 void
-Input_objects::print_cref(const Symbol_table* symtab, FILE* f) const
+Input_objects::print_cref(const Symbol_table* symtab, FILE* f,
+			  bool is_json) const
 {
   if (parameters->options().cref() && this->cref_ != NULL)
-    this->cref_->print_cref(symtab, f);
+    this->cref_->print_cref(symtab, f, is_json);
 }
 
 // Relocate_info methods.
@@ -851,6 +851,10 @@ class General_options
 	      N_("Dynamic hash style"), N_("[sysv,gnu,both]"),
 	      {"sysv", "gnu", "both"});
 
+  DEFINE_bool(hash_bloom_optimize, options::TWO_DASHES, '\0', false,
+	      N_("Size GNU hash bloom filter for fast lookups"),
+	      N_("Use the default GNU hash bloom filter size (default)"));
+
   DEFINE_string(dynamic_linker, options::TWO_DASHES, 'I', NULL,
 		N_("Set dynamic linker path"), N_("PROGRAM"));
 
@@ -916,6 +920,10 @@ class General_options
   DEFINE_dirlist(library_path, options::TWO_DASHES, 'L',
 		 N_("Add directory to search path"), N_("DIR"));
 
+  DEFINE_string(library_path_cache, options::TWO_DASHES, '\0', NULL,
+		N_("Cache the contents of library search directories in FILE"),
+		N_("FILE"));
+
   DEFINE_bool(text_reorder, options::TWO_DASHES, '\0', true,
 	      N_("Enable text section reordering for GCC section names "
 		 "(default)"),
@@ -945,6 +953,10 @@ class General_options
   DEFINE_string(Map, options::ONE_DASH, '\0', NULL, N_("Write map file"),
 		N_("MAPFILENAME"));
 
+  DEFINE_enum(map_format, options::TWO_DASHES, '\0', "text",
+	      N_("Map file format; json writes one JSON object per line"),
+	      N_("[text,json]"), {"text", "json"});
+
   DEFINE_bool(nmagic, options::TWO_DASHES, 'n', false,
 	      N_("Do not page align data"), NULL);
   DEFINE_bool(omagic, options::EXACTLY_TWO_DASHES, 'N', false,
@@ -965,6 +977,11 @@ class General_options
   DEFINE_string(output, options::TWO_DASHES, 'o', "a.out",
 		N_("Set output file name"), N_("FILE"));
 
+  DEFINE_bool(output_writeback, options::TWO_DASHES, '\0', false,
+	      N_("Start writing each part of the output file to disk "
+		 "as soon as it is finished"),
+	      N_("Leave writing the output file to the system (default)"));
+
   DEFINE_uint(optimize, options::EXACTLY_ONE_DASH, 'O', 0,
 	      N_("Optimize output file size"), N_("LEVEL"));
 
@@ -1013,6 +1030,14 @@ class General_options
 		 " (default)."),
 	      N_("Use fallocate or ftruncate to reserve space."));
 
+  DEFINE_bool(prefetch_inputs, options::TWO_DASHES, '\0', false,
+	      N_("Ask the system to read input files ahead of use"),
+	      N_("Do not read input files ahead of use (default)"));
+  DEFINE_uint64(prefetch_inputs_size, options::TWO_DASHES, '\0',
+		256 * 1024 * 1024,
+		N_("Maximum number of bytes of input files to read ahead"),
+		N_("SIZE"));
+
   DEFINE_bool(preread_archive_symbols, options::TWO_DASHES, '\0', false,
 	      N_("Preread archive symbols when multi-threaded"), NULL);
 
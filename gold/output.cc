@@ -4854,6 +4854,11 @@ Output_segment::print_section_list_to_mapfile(Mapfile* mapfile,
 
 // Output_file methods.
 
+#ifdef HAVE_SYNC_FILE_RANGE
+// The page size used by Output_file::start_writeback.
+static off_t writeback_page_size;
+#endif
+
 Output_file::Output_file(const char* name)
   : name_(name),
     o_(-1),
@@ -4861,7 +4866,8 @@ Output_file::Output_file(const char* name)
     base_(NULL),
     map_is_anonymous_(false),
     map_is_allocated_(false),
-    is_temporary_(false)
+    is_temporary_(false),
+    writeback_(false)
 {
 }
 
@@ -5046,6 +5052,26 @@ Output_file::resize(off_t file_size)
     }
   else
     {
+#ifdef HAVE_MREMAP
+      // When growing, reserve the new space and extend the mapping in
+      // place, rather than unmapping the file and flushing what we
+      // have written so far.
+      if (file_size > this->file_size_)
+	{
+	  int err = gold_fallocate(this->o_, this->file_size_,
+				   file_size - this->file_size_);
+	  if (err != 0)
+	    gold_fatal(_("%s: %s"), this->name_, strerror(err));
+	  void* base = ::mremap(this->base_, this->file_size_, file_size,
+				MREMAP_MAYMOVE);
+	  if (base != MAP_FAILED)
+	    {
+	      this->base_ = static_cast<unsigned char*>(base);
+	      this->file_size_ = file_size;
+	      return;
+	    }
+	}
+#endif
       this->unmap();
       this->file_size_ = file_size;
       if (!this->map_no_anonymous(true))
@@ -5131,7 +5157,15 @@ Output_file::map()
 {
   if (parameters->options().mmap_output_file()
       && this->map_no_anonymous(true))
-    return;
+    {
+#ifdef HAVE_SYNC_FILE_RANGE
+      this->writeback_ = (parameters->options().output_writeback()
+			  && !this->is_temporary_);
+      if (this->writeback_ && writeback_page_size == 0)
+	writeback_page_size = ::sysconf(_SC_PAGESIZE);
+#endif
+      return;
+    }
 
   // The mmap call might fail because of file system issues: the file
   // system might not support mmap at all, or it might not support
@@ -5164,6 +5198,58 @@ Output_file::unmap()
   this->base_ = NULL;
 }
 
+// Start writing the SIZE bytes at START to disk.  This is called for
+// each view when we have finished writing it, so with a big output
+// file the disk is kept busy while we are still linking, rather than
+// being left a large amount of dirty data at the end.  We only write
+// whole pages, since the pages at either end may be shared with data
+// which has not been written yet.  Anything left over is written when
+// the file is closed.
+
+void
+Output_file::start_writeback(off_t start, size_t size)
+{
+#ifdef HAVE_SYNC_FILE_RANGE
+  const off_t page_size = writeback_page_size;
+  off_t begin = (start + page_size - 1) & ~(page_size - 1);
+  off_t end = (start + static_cast<off_t>(size)) & ~(page_size - 1);
+  if (end > begin)
+    ::sync_file_range(this->o_, begin, end - begin, SYNC_FILE_RANGE_WRITE);
+#else
+  gold_unreachable();
+#endif
+}
+
+// Return whether the LEN bytes at P are all zero.
+
+static inline bool
+is_zero_block(const unsigned char* p, size_t len)
+{
+  return p[0] == 0 && memcmp(p, p + 1, len - 1) == 0;
+}
+
+// Write LEN bytes at P to the descriptor O.
+
+static void
+write_buffer(const char* name, int o, const unsigned char* p, size_t len)
+{
+  size_t bytes_to_write = len;
+  size_t offset = 0;
+  while (bytes_to_write > 0)
+    {
+      ssize_t bytes_written = ::write(o, p + offset, bytes_to_write);
+      if (bytes_written == 0)
+	gold_error(_("%s: write: unexpected 0 return-value"), name);
+      else if (bytes_written < 0)
+	gold_error(_("%s: write: %s"), name, strerror(errno));
+      else
+	{
+	  bytes_to_write -= bytes_written;
+	  offset += bytes_written;
+	}
+    }
+}
+
 // Close the output file.
 
 void
@@ -5172,23 +5258,70 @@ Output_file::close()
   // If the map isn't file-backed, we need to write it now.
   if (this->map_is_anonymous_ && !this->is_temporary_)
     {
-      size_t bytes_to_write = this->file_size_;
+      // When writing to a regular file, we leave large blocks of
+      // zeroes, such as alignment padding, as holes in the file.  We
+      // write the file in pieces, and with --output-writeback we
+      // start writing each piece to disk as soon as we have given it
+      // to the kernel.
+      struct stat s;
+      bool is_regular = (this->o_ != STDOUT_FILENO
+			 && ::fstat(this->o_, &s) == 0
+			 && S_ISREG(s.st_mode));
+      const size_t block_size = 64 * 1024;
+      const size_t max_write = 256 * block_size;
+      size_t file_size = this->file_size_;
       size_t offset = 0;
-      while (bytes_to_write > 0)
+      bool skipped = false;
+      while (offset < file_size)
 	{
-	  ssize_t bytes_written = ::write(this->o_, this->base_ + offset,
-					  bytes_to_write);
-	  if (bytes_written == 0)
-	    gold_error(_("%s: write: unexpected 0 return-value"), this->name_);
-	  else if (bytes_written < 0)
-	    gold_error(_("%s: write: %s"), this->name_, strerror(errno));
-	  else
+	  if (!is_regular)
 	    {
-	      bytes_to_write -= bytes_written;
-	      offset += bytes_written;
+	      write_buffer(this->name_, this->o_, this->base_, file_size);
+	      break;
 	    }
+
+	  size_t zeroes = 0;
+	  while (offset + zeroes + block_size <= file_size
+		 && is_zero_block(this->base_ + offset + zeroes, block_size))
+	    zeroes += block_size;
+	  if (zeroes > 0)
+	    {
+	      offset += zeroes;
+	      if (::lseek(this->o_, offset, SEEK_SET) < 0)
+		gold_fatal(_("%s: lseek: %s"), this->name_, strerror(errno));
+	      skipped = true;
+	      continue;
+	    }
+
+	  size_t len = std::min(block_size, file_size - offset);
+	  while (offset + len < file_size
+		 && len < max_write
+		 && (offset + len + block_size > file_size
+		     || !is_zero_block(this->base_ + offset + len,
+				       block_size)))
+	    len += std::min(block_size, file_size - (offset + len));
+
+	  write_buffer(this->name_, this->o_, this->base_ + offset, len);
+#ifdef HAVE_SYNC_FILE_RANGE
+	  if (parameters->options().output_writeback())
+	    ::sync_file_range(this->o_, offset, len, SYNC_FILE_RANGE_WRITE);
+#endif
+	  offset += len;
 	}
+
+      // If the file ends with a hole, set the size explicitly.
+      if (skipped && ::ftruncate(this->o_, file_size) < 0)
+	gold_error(_("%s: ftruncate: %s"), this->name_, strerror(errno));
     }
+#ifdef HAVE_SYNC_FILE_RANGE
+  else if (!this->map_is_anonymous_
+	   && parameters->options().output_writeback())
+    {
+      // Start writing whatever start_writeback did not, rather than
+      // leaving it to the kernel after we exit.
+      ::sync_file_range(this->o_, 0, 0, SYNC_FILE_RANGE_WRITE);
+    }
+#endif
   this->unmap();
 
   // We don't close stdout or stderr
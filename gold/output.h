@@ -3515,7 +3515,7 @@ class Output_section : public Output_data
   {
    public:
     Input_section()
-      : shndx_(0), p2align_(0)
+      : shndx_(0), p2align_(0), section_order_index_(0)
     {
       this->u1_.data_size = 0;
       this->u2_.object = NULL;
@@ -3572,9 +3572,14 @@ class Output_section : public Output_data
       return this->section_order_index_;
     }
 
+    // Set the section order index.  An index too large to store is
+    // clamped to the largest one we can store; those sections then
+    // sort after all others, in their original order.
     void
     set_section_order_index(unsigned int number)
     {
+      if (number > max_section_order_index)
+	number = max_section_order_index;
       this->section_order_index_ = number;
     }
 
@@ -3774,13 +3779,24 @@ class Output_section : public Output_data
       RELAXED_INPUT_SECTION_CODE = -4U
     };
 
+    // The number of bits used to store the section order index.
+    static const int section_order_index_bits = 25;
+    // The largest section order index we can store.
+    static const unsigned int max_section_order_index =
+      (1U << section_order_index_bits) - 1;
+
     // For an ordinary input section, this is the section index in the
     // input file.  For an Output_section_data, this is
     // OUTPUT_SECTION_CODE or MERGE_DATA_SECTION_CODE or
     // MERGE_STRING_SECTION_CODE.
     unsigned int shndx_;
-    // The required alignment, stored as a power of 2.
-    unsigned int p2align_;
+    // The required alignment, stored as a power of 2 plus 1, or 0 if
+    // not set.  This needs 7 bits.  It shares a word with the section
+    // order index to keep this structure small.
+    unsigned int p2align_ : 7;
+    // The line number of the pattern it matches in the --section-ordering-file
+    // file.  It is 0 if does not match any pattern.
+    unsigned int section_order_index_ : section_order_index_bits;
     union
     {
       // For an ordinary input section, the section size.
@@ -3802,9 +3818,6 @@ class Output_section : public Output_data
       // For RELAXED_INPUT_SECTION_CODE, the data.
       Output_relaxed_input_section* poris;
     } u2_;
-    // The line number of the pattern it matches in the --section-ordering-file
-    // file.  It is 0 if does not match any pattern.
-    unsigned int section_order_index_;
   };
 
   // Store the list of input sections for this Output_section into the
@@ -4781,8 +4794,11 @@ class Output_file
   // VIEW must have been returned by get_output_view.  Write the
   // buffer to the file, passing in the offset and the size.
   void
-  write_output_view(off_t, size_t, unsigned char*)
-  { }
+  write_output_view(off_t start, size_t size, unsigned char*)
+  {
+    if (this->writeback_)
+      this->start_writeback(start, size);
+  }
 
   // Get a read/write buffer.  This is used when we want to write part
   // of the file, read it in, and write it again.
@@ -4792,8 +4808,11 @@ class Output_file
 
   // Write a read/write buffer back to the file.
   void
-  write_input_output_view(off_t, size_t, unsigned char*)
-  { }
+  write_input_output_view(off_t start, size_t size, unsigned char*)
+  {
+    if (this->writeback_)
+      this->start_writeback(start, size);
+  }
 
   // Get a read buffer.  This is used when we just want to read part
   // of the file back it in.
@@ -4824,6 +4843,11 @@ class Output_file
   void
   unmap();
 
+  // Start writing a finished part of the file to disk, for
+  // --output-writeback.
+  void
+  start_writeback(off_t start, size_t size);
+
   // File name.
   const char* name_;
   // File descriptor.
@@ -4838,6 +4862,8 @@ class Output_file
   bool map_is_allocated_;
   // True if this is a temporary file which should not be output.
   bool is_temporary_;
+  // True if finished views should be written to disk right away.
+  bool writeback_;
 };
 
 } // End namespace gold.
@@ -130,18 +130,13 @@ Read_symbols::requeue(Workqueue* workqueue, Input_objects* input_objects,
 				    input_group, NULL, NULL, next_blocker));
 }
 
-// Return whether a Read_symbols task is runnable.  We can read an
-// ordinary input file immediately.  For an archive specified using
-// -l, we have to wait until the search path is complete.
+// Return whether a Read_symbols task is runnable.  We can always
+// run: a search for an archive specified using -l reads any directory
+// it needs which has not been read yet.
 
 Task_token*
 Read_symbols::is_runnable()
 {
-  if (this->input_argument_->is_file()
-      && this->input_argument_->file().may_need_search()
-      && this->dirpath_->token()->is_blocked())
-    return this->dirpath_->token();
-
   return NULL;
 }
 
@@ -943,4 +938,38 @@ Read_script::get_name() const
   return ret;
 }
 
+// Class Prefetch_inputs.
+
+// Walk the input files in command line order, prefetching each one
+// until we run out of budget.
+
+void
+Prefetch_inputs::run(Workqueue*)
+{
+  off_t budget = parameters->options().prefetch_inputs_size();
+  this->prefetch_list(this->begin_, this->end_, &budget);
+}
+
+// Prefetch the files in a list of input arguments.  We can't prefetch
+// libraries found with -l, as we don't know where they are until the
+// directory search is complete.  Files named in linker scripts are
+// only found when the script is read, so they are not prefetched
+// either.
+
+void
+Prefetch_inputs::prefetch_list(Input_argument_list::const_iterator p,
+			       Input_argument_list::const_iterator pend,
+			       off_t* budget)
+{
+  for (; p != pend && *budget > 0; ++p)
+    {
+      if (p->is_group())
+	this->prefetch_list(p->group()->begin(), p->group()->end(), budget);
+      else if (p->is_lib())
+	this->prefetch_list(p->lib()->begin(), p->lib()->end(), budget);
+      else if (!p->file().is_lib() && !p->file().is_searched_file())
+	*budget -= File_read::prefetch(p->file().name(), *budget);
+    }
+}
+
 } // End namespace gold.
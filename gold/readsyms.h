@@ -486,6 +486,47 @@ class Read_script : public Task
   Task_token* next_blocker_;
 };
 
+// This Task walks the input files on the command line and asks the
+// system to start reading them, so that the I/O is already under way
+// by the time the Read_symbols tasks get to them.  It does not block
+// anything, and nothing waits for it.
+
+class Prefetch_inputs : public Task
+{
+ public:
+  Prefetch_inputs(Input_arguments::const_iterator begin,
+		  Input_arguments::const_iterator end)
+    : begin_(begin), end_(end)
+  { }
+
+  // The standard Task methods.
+
+  Task_token*
+  is_runnable()
+  { return NULL; }
+
+  void
+  locks(Task_locker*)
+  { }
+
+  void
+  run(Workqueue*);
+
+  std::string
+  get_name() const
+  { return "Prefetch_inputs"; }
+
+ private:
+  // Prefetch the files in the list [P, PEND), using at most *BUDGET
+  // bytes, and reduce *BUDGET by the number of bytes used.
+  void
+  prefetch_list(Input_argument_list::const_iterator p,
+		Input_argument_list::const_iterator pend, off_t* budget);
+
+  Input_arguments::const_iterator begin_;
+  Input_arguments::const_iterator end_;
+};
+
 } // end namespace gold
 
 #endif // !defined(GOLD_READSYMS_H)
@@ -25,6 +25,7 @@
 #include <cstring>
 #include <stdint.h>
 #include <algorithm>
+#include <new>
 #include <set>
 #include <string>
 #include <utility>
@@ -562,7 +563,8 @@ Symbol::set_undefined()
 
 Symbol_table::Symbol_table(unsigned int count,
                            const Version_script_info& version_script)
-  : saw_undefined_(0), offset_(0), table_(count), namepool_(),
+  : saw_undefined_(0), offset_(0), table_(count), symbol_blocks_(),
+    symbol_block_next_(NULL), symbol_block_left_(0), namepool_(),
     forwarders_(), commons_(), tls_commons_(), small_commons_(),
     large_commons_(), forced_locals_(), warnings_(),
     version_script_(version_script), gc_(NULL), icf_(NULL)
@@ -572,6 +574,10 @@ Symbol_table::Symbol_table(unsigned int count,
 
 Symbol_table::~Symbol_table()
 {
+  for (std::vector<unsigned char*>::iterator p = this->symbol_blocks_.begin();
+       p != this->symbol_blocks_.end();
+       ++p)
+    delete[] *p;
 }
 
 // The symbol table key equality function.  This is called with
@@ -886,6 +892,35 @@ Symbol_table::define_default_version(Sized_symbol<size>* sym,
     }
 }
 
+// Allocate a new symbol.  Symbols are never freed individually, so we
+// carve them out of large blocks, which saves the per-allocation
+// overhead of the heap and keeps symbols from the same object close
+// together in memory.
+
+template<int size>
+Sized_symbol<size>*
+Symbol_table::allocate_symbol()
+{
+  // The number of symbols we allocate at a time.
+  const size_t symbols_per_block = 4096;
+
+  const size_t symbol_size = sizeof(Sized_symbol<size>);
+  if (this->symbol_block_left_ < symbol_size)
+    {
+      const size_t block_size = symbol_size * symbols_per_block;
+      unsigned char* block = new unsigned char[block_size];
+      this->symbol_blocks_.push_back(block);
+      this->symbol_block_next_ = block;
+      this->symbol_block_left_ = block_size;
+    }
+
+  Sized_symbol<size>* ret =
+    new(this->symbol_block_next_) Sized_symbol<size>();
+  this->symbol_block_next_ += symbol_size;
+  this->symbol_block_left_ -= symbol_size;
+  return ret;
+}
+
 // Add one symbol from OBJECT to the symbol table.  NAME is symbol
 // name and VERSION is the version; both are canonicalized.  DEF is
 // whether this is the default version.  ST_SHNDX is the symbol's
@@ -1028,7 +1063,7 @@ Symbol_table::add_from_object(Object* object,
 	  Sized_target<size, big_endian>* target =
 	    parameters->sized_target<size, big_endian>();
 	  if (!target->has_make_symbol())
-	    ret = new Sized_symbol<size>();
+	    ret = this->allocate_symbol<size>();
 	  else
 	    {
 	      ret = target->make_symbol();
@@ -3235,6 +3270,8 @@ Symbol_table::print_stats() const
   fprintf(stderr, _("%s: symbol table entries: %zu\n"),
 	  program_name, this->table_.size());
 #endif
+  fprintf(stderr, _("%s: symbol table blocks: %zu\n"),
+	  program_name, this->symbol_blocks_.size());
   this->namepool_.print_stats("symbol table stringpool");
 }
 
@@ -1353,6 +1353,35 @@ class Symbol_table
     SORT_COMMONS_BY_ALIGNMENT_ASCENDING
   };
 
+  // An entry in a list of common symbols to sort.  The sort keys are
+  // copied out of the symbol so that comparisons do not have to look
+  // at the symbol itself.
+  struct Common_sort_entry
+  {
+    // The alignment of the symbol.
+    uint64_t align;
+    // The size of the symbol.
+    uint64_t size;
+    // The name of the symbol.
+    const char* name;
+    // The symbol.
+    Symbol* sym;
+  };
+
+  typedef std::vector<Common_sort_entry> Common_sort_list;
+
+  // The number of different kinds of common symbols.
+  static const int commons_section_type_count = 4;
+
+  // The common symbols to allocate, gathered by gather_commons.
+  struct Commons_to_sort
+  {
+    // How to sort the symbols.
+    Sort_commons_order sort_order;
+    // The symbols, indexed by Commons_section_type.
+    Common_sort_list lists[commons_section_type_count];
+  };
+
   // COUNT is an estimate of how many symbols will be inserted in the
   // symbol table.  It's ok to put 0 if you don't know; a correct
   // guess will just save some CPU by reducing hashtable resizes.
@@ -1510,6 +1539,22 @@ class Symbol_table
   void
   allocate_commons(Layout*, Mapfile*);
 
+  // Move the common symbols into TO_SORT, to be sorted and then
+  // passed to allocate_sorted_commons.  This is used when sorting
+  // the symbols in parallel.
+  void
+  gather_commons(Commons_to_sort* to_sort);
+
+  // Sort the common symbols from BEGIN to END.
+  static void
+  sort_commons(Sort_commons_order, Common_sort_entry* begin,
+	       Common_sort_entry* end);
+
+  // Allocate the common symbols gathered in TO_SORT, once each list
+  // has been sorted.
+  void
+  allocate_sorted_commons(Layout*, Mapfile*, Commons_to_sort* to_sort);
+
   // Add a warning for symbol NAME in object OBJ.  WARNING is the text
   // of the warning.
   void
@@ -1684,6 +1729,11 @@ class Symbol_table
   void
   make_forwarder(Symbol* from, Symbol* to);
 
+  // Allocate a new symbol from the symbol arena.
+  template<int size>
+  Sized_symbol<size>*
+  allocate_symbol();
+
   // Add a symbol.
   template<int size, bool big_endian>
   Sized_symbol<size>*
@@ -1817,16 +1867,21 @@ class Symbol_table
     COMMONS_LARGE
   };
 
-  // Allocate the common symbols, sized version.
+  // Gather the common symbols, sized version.
+  template<int size>
+  void
+  do_gather_commons(Commons_to_sort*);
+
+  // Gather the common symbols from one list.
   template<int size>
   void
-  do_allocate_commons(Layout*, Mapfile*, Sort_commons_order);
+  do_gather_commons_list(Commons_type*, Common_sort_list*);
 
-  // Allocate the common symbols from one list.
+  // Allocate the sorted common symbols from one list.
   template<int size>
   void
-  do_allocate_commons_list(Layout*, Commons_section_type, Commons_type*,
-			   Mapfile*, Sort_commons_order);
+  do_allocate_commons_list(Layout*, Commons_section_type, Common_sort_list*,
+			   Mapfile*);
 
   // Returns all of the lines attached to LOC, not just the one the
   // instruction actually came from.  This helps the ODR checker avoid
@@ -1905,6 +1960,14 @@ class Symbol_table
   unsigned int dynamic_count_;
   // The symbol hash table.
   Symbol_table_type table_;
+  // Blocks of memory from which we allocate the symbols we read from
+  // input files.  There can be tens of millions of them, so we avoid
+  // a separate heap allocation for each one.
+  std::vector<unsigned char*> symbol_blocks_;
+  // The next free byte in the last entry in symbol_blocks_.
+  unsigned char* symbol_block_next_;
+  // The number of free bytes at symbol_block_next_.
+  size_t symbol_block_left_;
   // A pool of symbol names.  This is used for all global symbols.
   // Entries in the hash table point into this pool.
   Stringpool namepool_;
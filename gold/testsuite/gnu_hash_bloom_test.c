@@ -0,0 +1,77 @@
+/* gnu_hash_bloom_test.c -- test --hash-bloom-optimize
+
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is part of gold.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+   MA 02110-1301, USA.  */
+
+/* gnu_hash_bloom_test.so is linked from gnu_hash_opt_test.c with
+   --hash-style=gnu --hash-bloom-optimize, so the dynamic linker can
+   only find its symbols through .gnu.hash, after checking the bloom
+   filter gold sized.  Look up every symbol it defines, and check
+   that a few it does not define are not found.  */
+
+#include <dlfcn.h>
+#include <stdio.h>
+
+#define SYMBOL_COUNT 8192
+
+int
+main (void)
+{
+  char name[64];
+  void *h;
+  int i;
+  int errors = 0;
+
+  h = dlopen ("gnu_hash_bloom_test.so", RTLD_NOW);
+  if (h == NULL)
+    {
+      printf ("cannot load: %s\n", dlerror ());
+      return 1;
+    }
+
+  for (i = 1; i <= SYMBOL_COUNT; ++i)
+    {
+      int *p;
+
+      sprintf (name, "gnu_hash_sym_%d", i);
+      p = (int *) dlsym (h, name);
+      if (p == NULL)
+	{
+	  printf ("symbol not found: %s\n", name);
+	  ++errors;
+	}
+      else if (*p != i)
+	{
+	  printf ("%s is %d, expected %d\n", name, *p, i);
+	  ++errors;
+	}
+    }
+
+  for (i = SYMBOL_COUNT + 1; i <= SYMBOL_COUNT + 16; ++i)
+    {
+      sprintf (name, "gnu_hash_sym_%d", i);
+      if (dlsym (h, name) != NULL)
+	{
+	  printf ("unexpected symbol found: %s\n", name);
+	  ++errors;
+	}
+    }
+
+  return errors != 0;
+}
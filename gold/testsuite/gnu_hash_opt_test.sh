@@ -0,0 +1,43 @@
+#!/bin/sh
+
+# gnu_hash_opt_test.sh -- test -O1 sizing of the .gnu.hash table
+
+# Copyright (C) 2026 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# This file goes with gnu_hash_opt_test.c, which defines 8192
+# symbols.  With that many symbols every size probed by the first
+# -O1 pass is a multiple of 32, which gold used to skip, so it never
+# finished choosing a bucket count.  Check that the link completed
+# and that the chosen count is not a multiple of 32.
+
+buckets=`sed -n "s/^Histogram for .\.gnu\.hash' bucket list length (total of \([0-9]*\) buckets).*/\1/p" gnu_hash_opt_test.stdout`
+if test -z "$buckets"; then
+  echo "Did not find .gnu.hash histogram in gnu_hash_opt_test.stdout"
+  echo ""
+  echo "Actual output below:"
+  cat gnu_hash_opt_test.stdout
+  exit 1
+fi
+if test `expr $buckets % 32` -eq 0; then
+  echo "Bucket count $buckets is a multiple of 32"
+  exit 1
+fi
+
+exit 0
@@ -0,0 +1,70 @@
+#!/bin/sh
+
+# library_path_cache_test.sh -- test --library-path-cache
+
+# Copyright (C) 2026 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# The first link, with -llpc_a, writes library_path_cache_test.cache,
+# recording library_path_cache_test.dir with only liblpc_a.a in it.
+# liblpc_b.a is then added to the directory:
+#  link 2: the directory's time is set back, so the cache is reused
+#          and -llpc_b is not found.
+#  link 3: the directory's time is current, so it is read again and
+#          -llpc_b is found.
+#  link 4: the directory's time is set back again, but the cache file
+#          now ends with garbage, so the whole file is ignored and
+#          -llpc_b is found.
+
+check()
+{
+    if ! grep -q "$2" "$1"
+    then
+	echo "Did not find expected output in $1:"
+	echo "   $2"
+	echo ""
+	echo "Actual output below:"
+	cat "$1"
+	exit 1
+    fi
+}
+
+check_missing()
+{
+    if grep -q "$2" "$1"
+    then
+	echo "Found unexpected output in $1:"
+	echo "   $2"
+	echo ""
+	echo "Actual output below:"
+	cat "$1"
+	exit 1
+    fi
+}
+
+check library_path_cache_test.cache "^gold-library-path-cache 1$"
+check library_path_cache_test.cache "^library_path_cache_test.dir$"
+check library_path_cache_test.cache "^liblpc_a.a$"
+
+check library_path_cache_test.stdout "cannot find -llpc_b"
+check library_path_cache_test.stdout "link 2 failed"
+check_missing library_path_cache_test.stdout "link 3 failed"
+check_missing library_path_cache_test.stdout "link 4 failed"
+
+exit 0
@@ -0,0 +1,76 @@
+#!/bin/sh
+
+# map_json_test.sh -- test --map-format=json
+
+# Copyright (C) 2026 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# map_json_test.stdout is the map file written by linking
+# two_file_test_1.o and two_file_test_2.o with --map-format=json
+# --cref.  Each line should be a JSON object with a "type" field.
+# Parse it with Python if we have it; otherwise just check the shape
+# of each line.
+
+map=map_json_test.stdout
+
+check()
+{
+    if ! grep -q "$2" "$1"
+    then
+	echo "Did not find expected output in $1:"
+	echo "   $2"
+	echo ""
+	echo "Actual output below:"
+	cat "$1"
+	exit 1
+    fi
+}
+
+check $map '^{"type":"output_section","name":".debug_info",'
+check $map '^{"type":"input_section",.*"file":"two_file_test_1.o"}$'
+check $map '^{"type":"cref","symbol":"t1()",'
+
+python=
+for p in python3 python; do
+  if $p -c "import json" > /dev/null 2>&1; then
+    python=$p
+    break
+  fi
+done
+
+if test -n "$python"; then
+  $python -c '
+import json, sys
+for n, line in enumerate(open(sys.argv[1]), 1):
+    try:
+        obj = json.loads(line)
+    except ValueError as e:
+        sys.exit("%s:%d: %s" % (sys.argv[1], n, e))
+    if not isinstance(obj, dict) or "type" not in obj:
+        sys.exit("%s:%d: no type field" % (sys.argv[1], n))
+' $map || exit 1
+else
+  if grep -v '^{"type":".*}$' $map > /dev/null; then
+    echo "Lines which are not JSON objects in $map:"
+    grep -v '^{"type":".*}$' $map
+    exit 1
+  fi
+fi
+
+exit 0
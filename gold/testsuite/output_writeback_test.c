@@ -0,0 +1,29 @@
+/* output_writeback_test.c -- test --output-writeback
+
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is part of gold.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+   MA 02110-1301, USA.
+
+   The zeroes in this section are large enough that gold leaves a
+   hole in the output file for them when it writes the output from a
+   buffer.  The data after them checks that the hole ends in the right
+   place.  */
+
+char zeroes[1024 * 1024] __attribute__ ((section (".data.zeroes"))) = { 0 };
+int after_zeroes[4] __attribute__ ((section (".data.zeroes")))
+  = { 1, 2, 3, 4 };
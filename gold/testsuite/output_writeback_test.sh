@@ -0,0 +1,37 @@
+#!/bin/sh
+
+# output_writeback_test.sh -- test --output-writeback
+
+# Copyright (C) 2026 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# output_writeback_test_1.o is output_writeback_test.o linked with -r.
+# output_writeback_test_2.o is the same link with --output-writeback,
+# and output_writeback_test_3.o adds --no-mmap-output-file, so that
+# the output is written from a buffer and the zeroes in the input
+# become a hole.  All three should be the same.
+
+for f in output_writeback_test_2.o output_writeback_test_3.o; do
+  if ! cmp output_writeback_test_1.o $f; then
+    echo "$f differs from output_writeback_test_1.o"
+    exit 1
+  fi
+done
+
+exit 0
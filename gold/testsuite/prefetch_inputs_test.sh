@@ -0,0 +1,51 @@
+#!/bin/sh
+
+# prefetch_inputs_test.sh -- test --prefetch-inputs
+
+# Copyright (C) 2026 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# prefetch_inputs_test.o and prefetch_inputs_test_1.o are the same
+# three objects linked with -r, the second with --prefetch-inputs
+# --stats.  Check that the outputs are the same, and that the stats
+# in prefetch_inputs_test.stdout show that all three inputs were
+# prefetched before they were opened.
+
+check()
+{
+    if ! grep -q "$2" "$1"
+    then
+	echo "Did not find expected output in $1:"
+	echo "   $2"
+	echo ""
+	echo "Actual output below:"
+	cat "$1"
+	exit 1
+    fi
+}
+
+if ! cmp -s prefetch_inputs_test.o prefetch_inputs_test_1.o; then
+  echo "--prefetch-inputs changed the output"
+  exit 1
+fi
+
+check prefetch_inputs_test.stdout "input files prefetched: 3 "
+check prefetch_inputs_test.stdout "input files opened after prefetch: 3; without prefetch: 0"
+
+exit 0
@@ -423,6 +423,13 @@ struct bfd_link_info
   /* TRUE if BND prefix in PLT entries is always generated.  */
   unsigned int bndplt: 1;
 
+  /* TRUE if, once a relaxation trip leaves every section where it
+     was, bfd_relax_section need only be called again for sections
+     that asked for another trip.  Set by emulations whose backend
+     relaxes each section from its own contents and the current
+     layout alone.  */
+  unsigned int relax_only_again_safe: 1;
+
   /* Char that may appear as the first char of a symbol, but should be
      skipped (like symbol_leading_char) when looking up symbols in
      wrap_hash.  Used by PowerPC Linux for 'dot' symbols.  */
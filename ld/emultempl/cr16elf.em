@@ -172,6 +172,11 @@ cr16elf_before_allocation (void)
      -r together.  */
   if (RELAXATION_DISABLED_BY_DEFAULT)
     ENABLE_RELAXATION;
+
+  /* The relax hook only looks at the section being relaxed and at
+     symbol values, so sections that did not ask to be relaxed again
+     need not be once the layout stops changing.  */
+  link_info.relax_only_again_safe = TRUE;
 }
 
 EOF
@@ -2228,6 +2228,13 @@ gld${EMULATION_NAME}_handle_option (int optc)
 	link_info.compress_debug = COMPRESS_DEBUG_GNU_ZLIB;
       else if (strcasecmp (optarg, "zlib-gabi") == 0)
 	link_info.compress_debug = COMPRESS_DEBUG_GABI_ZLIB;
+      else if (strcasecmp (optarg, "zstd") == 0)
+	{
+	  if (!bfd_zstd_supported ())
+	    einfo (_("%P%F: --compress-debug-sections=zstd: zstd support "
+		     "is not configured\n"));
+	  link_info.compress_debug = COMPRESS_DEBUG_ZSTD;
+	}
       else
 	einfo (_("%P%F: invalid --compress-debug-sections option: \`%s'\n"),
 	       optarg);
@@ -459,86 +459,111 @@ sort_by_name:
   return ret;
 }
 
-/* Build a Binary Search Tree to sort sections, unlike insertion sort
-   used in wild_sort(). BST is considerably faster if the number of
-   of sections are large.  */
+/* Compare the files containing sections ASEC and BSEC, as wild_sort
+   does for a wild statement with sorted file names.  Archive members
+   are ordered by the name of their archive and then by their own
+   name.  */
 
-static lang_section_bst_type **
-wild_sort_fast (lang_wild_statement_type *wild,
-		struct wildcard_list *sec,
-		lang_input_statement_type *file ATTRIBUTE_UNUSED,
-		asection *section)
+static int
+compare_section_file (asection *asec, asection *bsec)
 {
-  lang_section_bst_type **tree;
+  bfd *aarch, *barch;
+  const char *aname, *bname;
+  int ret;
 
-  tree = &wild->tree;
-  if (!wild->filenames_sorted
-      && (sec == NULL || sec->spec.sorted == none))
+  aarch = bfd_my_archive (asec->owner);
+  barch = bfd_my_archive (bsec->owner);
+  aname = aarch != NULL ? bfd_get_filename (aarch) : asec->owner->filename;
+  bname = barch != NULL ? bfd_get_filename (barch) : bsec->owner->filename;
+
+  ret = filename_cmp (aname, bname);
+  if (ret != 0 || (aarch == NULL && barch == NULL))
+    return ret;
+
+  return filename_cmp (asec->owner->filename, bsec->owner->filename);
+}
+
+/* The sorter whose sections are being sorted by qsort.  */
+
+static const lang_section_sorter_type *current_sorter;
+
+/* qsort comparison function for sections collected by a
+   lang_section_sorter.  Sections that compare equal keep the order in
+   which they were matched, so the result is the same as that of
+   inserting each in turn with wild_sort.  */
+
+static int
+compare_sorted_section (const void *a, const void *b)
+{
+  const lang_sorted_section_type *sa = (const lang_sorted_section_type *) a;
+  const lang_sorted_section_type *sb = (const lang_sorted_section_type *) b;
+  int ret;
+
+  if (current_sorter->filenames_sorted)
     {
-      /* Append at the right end of tree.  */
-      while (*tree)
-	tree = &((*tree)->right);
-      return tree;
+      ret = compare_section_file (sa->section, sb->section);
+      if (ret != 0)
+	return ret;
     }
 
-  while (*tree)
+  if (current_sorter->sort != none)
     {
-      /* Find the correct node to append this section.  */
-      if (compare_section (sec->spec.sorted, section, (*tree)->section) < 0)
-	tree = &((*tree)->left);
-      else
-	tree = &((*tree)->right);
+      ret = compare_section (current_sorter->sort, sa->section, sb->section);
+      if (ret != 0)
+	return ret;
     }
 
-  return tree;
+  if (sa->seq < sb->seq)
+    return -1;
+  return sa->seq > sb->seq;
 }
 
-/* Use wild_sort_fast to build a BST to sort sections.  */
+/* Return TRUE if SECTION from FILE may be collected by SORTER.
+   wild_sort compares a new section using the name of FILE, but
+   sections already placed using the name of their owner, so both
+   must agree.  Sections without an init priority are compared with
+   the others by name, which does not give a consistent order when
+   they are mixed with sections that have one.  */
 
-static void
-output_section_callback_fast (lang_wild_statement_type *ptr,
-			      struct wildcard_list *sec,
-			      asection *section,
-			      struct flag_info *sflag_list ATTRIBUTE_UNUSED,
-			      lang_input_statement_type *file,
-			      void *output)
+static bfd_boolean
+sortable_section_p (const lang_section_sorter_type *sorter,
+		    lang_input_statement_type *file,
+		    asection *section)
 {
-  lang_section_bst_type *node;
-  lang_section_bst_type **tree;
-  lang_output_section_statement_type *os;
-
-  os = (lang_output_section_statement_type *) output;
-
-  if (unique_section_p (section, os))
-    return;
+  if (sorter->filenames_sorted
+      && (file->the_bfd != section->owner
+	  || filename_cmp (file->filename, section->owner->filename) != 0))
+    return FALSE;
 
-  node = (lang_section_bst_type *) xmalloc (sizeof (lang_section_bst_type));
-  node->left = 0;
-  node->right = 0;
-  node->section = section;
+  if (sorter->sort == by_init_priority
+      && get_init_priority (bfd_get_section_name (section->owner,
+						  section)) == 0)
+    return FALSE;
 
-  tree = wild_sort_fast (ptr, sec, file, section);
-  if (tree != NULL)
-    *tree = node;
+  return TRUE;
 }
 
-/* Convert a sorted sections' BST back to list form.  */
+/* Sort the sections collected for PTR and add them to its children.  */
 
 static void
-output_section_callback_tree_to_list (lang_wild_statement_type *ptr,
-				      lang_section_bst_type *tree,
-				      void *output)
+add_sorted_sections (lang_wild_statement_type *ptr,
+		     lang_output_section_statement_type *output)
 {
-  if (tree->left)
-    output_section_callback_tree_to_list (ptr, tree->left, output);
-
-  lang_add_section (&ptr->children, tree->section, NULL,
-		    (lang_output_section_statement_type *) output);
+  lang_section_sorter_type *sorter = ptr->sorter;
+  unsigned int i;
 
-  if (tree->right)
-    output_section_callback_tree_to_list (ptr, tree->right, output);
+  if (sorter->count > 1)
+    {
+      current_sorter = sorter;
+      qsort (sorter->sections, sorter->count, sizeof (*sorter->sections),
+	     compare_sorted_section);
+      current_sorter = NULL;
+    }
 
-  free (tree);
+  for (i = 0; i < sorter->count; i++)
+    lang_add_section (&ptr->children, sorter->sections[i].section,
+		      sorter->sections[i].sflag_info, output);
+  sorter->count = 0;
 }
 
 /* Specialized, optimized routines for handling different kinds of
@@ -772,7 +797,7 @@ analyze_walk_wild_section_handler (lang_wild_statement_type *ptr)
   ptr->handler_data[1] = NULL;
   ptr->handler_data[2] = NULL;
   ptr->handler_data[3] = NULL;
-  ptr->tree = NULL;
+  ptr->sorter = NULL;
 
   /* Count how many wildcard_specs there are, and how many of those
      actually use wildcards in the name.  Also, bail out if any of the
@@ -1492,10 +1517,77 @@ next_matching_output_section_statement (lang_output_section_statement_type *os,
   return &entry->s.output_section_statement;
 }
 
+/* Classes of output statement that an orphan may follow, used by
+   lang_output_section_find_by_flags.  */
+
+enum orphan_follow
+{
+  follow_code,
+  follow_rodata,
+  follow_tls,
+  follow_sdata,
+  follow_data,
+  follow_bss,
+  follow_nonalloc
+};
+
+/* Return TRUE if an output statement with flags LOOK_FLAGS is one an
+   orphan with flags SEC_FLAGS in class KIND may follow, when no
+   statement matches SEC_FLAGS exactly.  Not used for follow_tls,
+   which needs to look at the order of the statements.  */
+
+static bfd_boolean
+orphan_may_follow (enum orphan_follow kind, flagword look_flags,
+		   flagword sec_flags)
+{
+  flagword differ = look_flags ^ sec_flags;
+
+  switch (kind)
+    {
+    case follow_code:
+      /* Try for a rw code section.  */
+      return !(differ & (SEC_HAS_CONTENTS | SEC_ALLOC | SEC_LOAD
+			 | SEC_CODE | SEC_SMALL_DATA | SEC_THREAD_LOCAL));
+    case follow_rodata:
+      /* .rodata can go after .text, .sdata2 after .rodata.  */
+      return (!(differ & (SEC_HAS_CONTENTS | SEC_ALLOC | SEC_LOAD
+			  | SEC_READONLY | SEC_SMALL_DATA))
+	      || (!(differ & (SEC_HAS_CONTENTS | SEC_ALLOC | SEC_LOAD
+			      | SEC_READONLY))
+		  && !(look_flags & SEC_SMALL_DATA)));
+    case follow_sdata:
+      /* .sdata goes after .data, .sbss after .sdata.  */
+      return (!(differ & (SEC_HAS_CONTENTS | SEC_ALLOC | SEC_LOAD
+			  | SEC_THREAD_LOCAL))
+	      || ((look_flags & SEC_SMALL_DATA)
+		  && !(sec_flags & SEC_HAS_CONTENTS)));
+    case follow_data:
+      /* .data goes after .rodata.  */
+      return !(differ & (SEC_HAS_CONTENTS | SEC_ALLOC | SEC_LOAD
+			 | SEC_SMALL_DATA | SEC_THREAD_LOCAL));
+    case follow_bss:
+      /* .bss goes after any other alloc section.  */
+      return !(differ & SEC_ALLOC);
+    case follow_nonalloc:
+      /* non-alloc go last.  */
+      return !(differ & SEC_DEBUGGING);
+    default:
+      abort ();
+    }
+}
+
 /* A variant of lang_output_section_find used by place_orphan.
    Returns the output statement that should precede a new output
    statement for SEC.  If an exact match is found on certain flags,
-   sets *EXACT too.  */
+   sets *EXACT too.
+
+   Statements are preferred in this order: the last exact match of
+   section type, the last statement SEC may follow of matching type,
+   the last exact match of any type, and the last statement SEC may
+   follow of any type.  All four candidates are found in a single walk
+   over the output statements, calling MATCH_TYPE at most once for
+   each, so that placing many orphans does not keep rescanning a
+   long statement list.  */
 
 lang_output_section_statement_type *
 lang_output_section_find_by_flags (const asection *sec,
@@ -1503,18 +1595,38 @@ lang_output_section_find_by_flags (const asection *sec,
 				   lang_match_sec_type_func match_type)
 {
   lang_output_section_statement_type *first, *look, *found;
+  lang_output_section_statement_type *exact_typed, *exact_any;
+  lang_output_section_statement_type *follow_typed, *follow_any;
   flagword look_flags, sec_flags, differ;
+  enum orphan_follow kind;
 
   /* We know the first statement on this list is *ABS*.  May as well
      skip it.  */
   first = &lang_output_section_statement.head->output_section_statement;
   first = first->next;
 
-  /* First try for an exact match.  */
   sec_flags = sec->flags;
-  found = NULL;
+  if ((sec_flags & SEC_ALLOC) == 0)
+    kind = follow_nonalloc;
+  else if ((sec_flags & SEC_CODE) != 0)
+    kind = follow_code;
+  else if ((sec_flags & SEC_READONLY) != 0)
+    kind = follow_rodata;
+  else if ((sec_flags & SEC_THREAD_LOCAL) != 0)
+    kind = follow_tls;
+  else if ((sec_flags & SEC_SMALL_DATA) != 0)
+    kind = follow_sdata;
+  else if ((sec_flags & SEC_HAS_CONTENTS) != 0)
+    kind = follow_data;
+  else
+    kind = follow_bss;
+
+  exact_typed = exact_any = NULL;
+  follow_typed = follow_any = NULL;
   for (look = first; look; look = look->next)
     {
+      bfd_boolean typed = TRUE;
+
       look_flags = look->flags;
       if (look->bfd_section != NULL)
 	{
@@ -1522,73 +1634,43 @@ lang_output_section_find_by_flags (const asection *sec,
 	  if (match_type && !match_type (link_info.output_bfd,
 					 look->bfd_section,
 					 sec->owner, sec))
-	    continue;
+	    typed = FALSE;
 	}
       differ = look_flags ^ sec_flags;
       if (!(differ & (SEC_HAS_CONTENTS | SEC_ALLOC | SEC_LOAD | SEC_READONLY
 		      | SEC_CODE | SEC_SMALL_DATA | SEC_THREAD_LOCAL)))
-	found = look;
-    }
-  if (found != NULL)
-    {
-      if (exact != NULL)
-	*exact = found;
-      return found;
-    }
-
-  if ((sec_flags & SEC_CODE) != 0
-      && (sec_flags & SEC_ALLOC) != 0)
-    {
-      /* Try for a rw code section.  */
-      for (look = first; look; look = look->next)
 	{
-	  look_flags = look->flags;
-	  if (look->bfd_section != NULL)
-	    {
-	      look_flags = look->bfd_section->flags;
-	      if (match_type && !match_type (link_info.output_bfd,
-					     look->bfd_section,
-					     sec->owner, sec))
-		continue;
-	    }
-	  differ = look_flags ^ sec_flags;
-	  if (!(differ & (SEC_HAS_CONTENTS | SEC_ALLOC | SEC_LOAD
-			  | SEC_CODE | SEC_SMALL_DATA | SEC_THREAD_LOCAL)))
-	    found = look;
+	  exact_any = look;
+	  if (typed)
+	    exact_typed = look;
 	}
-    }
-  else if ((sec_flags & SEC_READONLY) != 0
-	   && (sec_flags & SEC_ALLOC) != 0)
-    {
-      /* .rodata can go after .text, .sdata2 after .rodata.  */
-      for (look = first; look; look = look->next)
+      if (kind != follow_tls
+	  && orphan_may_follow (kind, look_flags, sec_flags))
 	{
-	  look_flags = look->flags;
-	  if (look->bfd_section != NULL)
-	    {
-	      look_flags = look->bfd_section->flags;
-	      if (match_type && !match_type (link_info.output_bfd,
-					     look->bfd_section,
-					     sec->owner, sec))
-		continue;
-	    }
-	  differ = look_flags ^ sec_flags;
-	  if (!(differ & (SEC_HAS_CONTENTS | SEC_ALLOC | SEC_LOAD
-			  | SEC_READONLY | SEC_SMALL_DATA))
-	      || (!(differ & (SEC_HAS_CONTENTS | SEC_ALLOC | SEC_LOAD
-			      | SEC_READONLY))
-		  && !(look_flags & SEC_SMALL_DATA)))
-	    found = look;
+	  follow_any = look;
+	  if (typed)
+	    follow_typed = look;
 	}
     }
-  else if ((sec_flags & SEC_THREAD_LOCAL) != 0
-	   && (sec_flags & SEC_ALLOC) != 0)
+
+  /* First try for an exact match.  */
+  if (exact_typed != NULL)
+    {
+      if (exact != NULL)
+	*exact = exact_typed;
+      return exact_typed;
+    }
+
+  if (kind == follow_nonalloc)
+    return follow_any;
+
+  if (kind == follow_tls)
     {
       /* .tdata can go after .data, .tbss after .tdata.  Treat .tbss
 	 as if it were a loaded section, and don't use match_type.  */
       bfd_boolean seen_thread_local = FALSE;
 
-      match_type = NULL;
+      found = NULL;
       for (look = first; look; look = look->next)
 	{
 	  look_flags = look->flags;
@@ -1613,89 +1695,16 @@ lang_output_section_find_by_flags (const asection *sec,
 	  else if (!(differ & (SEC_HAS_CONTENTS | SEC_ALLOC | SEC_LOAD)))
 	    found = look;
 	}
-    }
-  else if ((sec_flags & SEC_SMALL_DATA) != 0
-	   && (sec_flags & SEC_ALLOC) != 0)
-    {
-      /* .sdata goes after .data, .sbss after .sdata.  */
-      for (look = first; look; look = look->next)
-	{
-	  look_flags = look->flags;
-	  if (look->bfd_section != NULL)
-	    {
-	      look_flags = look->bfd_section->flags;
-	      if (match_type && !match_type (link_info.output_bfd,
-					     look->bfd_section,
-					     sec->owner, sec))
-		continue;
-	    }
-	  differ = look_flags ^ sec_flags;
-	  if (!(differ & (SEC_HAS_CONTENTS | SEC_ALLOC | SEC_LOAD
-			  | SEC_THREAD_LOCAL))
-	      || ((look_flags & SEC_SMALL_DATA)
-		  && !(sec_flags & SEC_HAS_CONTENTS)))
-	    found = look;
-	}
-    }
-  else if ((sec_flags & SEC_HAS_CONTENTS) != 0
-	   && (sec_flags & SEC_ALLOC) != 0)
-    {
-      /* .data goes after .rodata.  */
-      for (look = first; look; look = look->next)
-	{
-	  look_flags = look->flags;
-	  if (look->bfd_section != NULL)
-	    {
-	      look_flags = look->bfd_section->flags;
-	      if (match_type && !match_type (link_info.output_bfd,
-					     look->bfd_section,
-					     sec->owner, sec))
-		continue;
-	    }
-	  differ = look_flags ^ sec_flags;
-	  if (!(differ & (SEC_HAS_CONTENTS | SEC_ALLOC | SEC_LOAD
-			  | SEC_SMALL_DATA | SEC_THREAD_LOCAL)))
-	    found = look;
-	}
-    }
-  else if ((sec_flags & SEC_ALLOC) != 0)
-    {
-      /* .bss goes after any other alloc section.  */
-      for (look = first; look; look = look->next)
-	{
-	  look_flags = look->flags;
-	  if (look->bfd_section != NULL)
-	    {
-	      look_flags = look->bfd_section->flags;
-	      if (match_type && !match_type (link_info.output_bfd,
-					     look->bfd_section,
-					     sec->owner, sec))
-		continue;
-	    }
-	  differ = look_flags ^ sec_flags;
-	  if (!(differ & SEC_ALLOC))
-	    found = look;
-	}
-    }
-  else
-    {
-      /* non-alloc go last.  */
-      for (look = first; look; look = look->next)
-	{
-	  look_flags = look->flags;
-	  if (look->bfd_section != NULL)
-	    look_flags = look->bfd_section->flags;
-	  differ = look_flags ^ sec_flags;
-	  if (!(differ & SEC_DEBUGGING))
-	    found = look;
-	}
       return found;
     }
 
-  if (found || !match_type)
-    return found;
+  if (follow_typed != NULL || match_type == NULL)
+    return follow_typed;
 
-  return lang_output_section_find_by_flags (sec, NULL, NULL);
+  /* Nothing of a matching type; ignore section types.  */
+  if (exact_any != NULL)
+    return exact_any;
+  return follow_any;
 }
 
 /* Find the last output section before given output statement.
@@ -2437,6 +2446,7 @@ lang_add_section (lang_statement_list_type *ptr,
   /* Add a section reference to the list.  */
   new_section = new_stat (lang_input_section, ptr);
   new_section->section = section;
+  new_section->relax_again_trip = -1;
 }
 
 /* Handle wildcard sorting.  This returns the lang_input_section which
@@ -2589,6 +2599,57 @@ output_section_callback (lang_wild_statement_type *ptr,
     }
 }
 
+/* Collect SECTION to be sorted with the others matched by PTR once
+   the walk over PTR is complete.  */
+
+static void
+output_section_callback_sort (lang_wild_statement_type *ptr,
+			      struct wildcard_list *sec,
+			      asection *section,
+			      struct flag_info *sflag_info,
+			      lang_input_statement_type *file,
+			      void *output)
+{
+  lang_section_sorter_type *sorter = ptr->sorter;
+  lang_output_section_statement_type *os;
+  lang_sorted_section_type *entry;
+
+  if (sorter == NULL)
+    {
+      output_section_callback (ptr, sec, section, sflag_info, file, output);
+      return;
+    }
+
+  os = (lang_output_section_statement_type *) output;
+
+  /* Exclude sections that match UNIQUE_SECTION_LIST.  */
+  if (unique_section_p (section, os))
+    return;
+
+  if (!sortable_section_p (sorter, file, section))
+    {
+      /* The sections collected so far are in the order wild_sort
+	 would have given them.  Place them, then insertion sort the
+	 rest of the sections as wild_sort does.  */
+      add_sorted_sections (ptr, os);
+      ptr->sorter = NULL;
+      output_section_callback (ptr, sec, section, sflag_info, file, output);
+      return;
+    }
+
+  if (sorter->count == sorter->alloc)
+    {
+      sorter->alloc = sorter->alloc ? sorter->alloc * 2 : 64;
+      sorter->sections = (lang_sorted_section_type *)
+	xrealloc (sorter->sections, sorter->alloc * sizeof (*entry));
+    }
+
+  entry = &sorter->sections[sorter->count];
+  entry->section = section;
+  entry->sflag_info = sflag_info;
+  entry->seq = sorter->count++;
+}
+
 /* Check if all sections in a wild statement for a particular FILE
    are readonly.  */
 
@@ -2859,6 +2920,31 @@ load_symbols (lang_input_statement_type *entry,
   return entry->flags.loaded;
 }
 
+/* Set *SORTP to the way sections are sorted by each of the section
+   specs of S.  Return FALSE if the section specs sort differently.  */
+
+static bfd_boolean
+wild_section_sort (lang_wild_statement_type *s, sort_type *sortp)
+{
+  struct wildcard_list *sec;
+  sort_type sort = none;
+
+  for (sec = s->section_list; sec != NULL; sec = sec->next)
+    {
+      sort_type this_sort = sec->spec.sorted;
+
+      if (this_sort == by_none)
+	this_sort = none;
+      if (sec == s->section_list)
+	sort = this_sort;
+      else if (this_sort != sort)
+	return FALSE;
+    }
+
+  *sortp = sort;
+  return TRUE;
+}
+
 /* Handle a wild statement.  S->FILENAME or S->SECTION_LIST or both
    may be NULL, indicating that it is a wildcard.  Separate
    lang_input_section statements are created for each part of the
@@ -2871,21 +2957,26 @@ wild (lang_wild_statement_type *s,
       lang_output_section_statement_type *output)
 {
   struct wildcard_list *sec;
+  sort_type sort;
 
-  if (s->handler_data[0]
-      && s->handler_data[0]->spec.sorted == by_name
-      && !s->filenames_sorted)
+  if (s->children.head == NULL
+      && wild_section_sort (s, &sort)
+      && (s->filenames_sorted || sort != none))
     {
-      lang_section_bst_type *tree;
+      lang_section_sorter_type sorter;
 
-      walk_wild (s, output_section_callback_fast, output);
+      sorter.sections = NULL;
+      sorter.count = 0;
+      sorter.alloc = 0;
+      sorter.sort = sort;
+      sorter.filenames_sorted = s->filenames_sorted;
 
-      tree = s->tree;
-      if (tree)
-	{
-	  output_section_callback_tree_to_list (s, tree, output);
-	  s->tree = NULL;
-	}
+      s->sorter = &sorter;
+      walk_wild (s, output_section_callback_sort, output);
+      if (s->sorter != NULL)
+	add_sorted_sections (s, output);
+      s->sorter = NULL;
+      free (sorter.sections);
     }
   else
     walk_wild (s, output_section_callback, output);
@@ -4764,6 +4855,18 @@ os_region_check (lang_output_section_statement_type *os,
     }
 }
 
+/* Set by lang_relax_sections when the previous relaxation trip left
+   the layout unchanged and the emulation has said that the backend
+   allows it.  Only input sections that asked to be relaxed again can
+   then do anything different, so lang_size_sections_1 does not call
+   bfd_relax_section for the others.  */
+static bfd_boolean relax_only_again;
+
+/* Calls to bfd_relax_section, and those asking for another trip, for
+   the --stats report on each relaxation trip.  */
+static unsigned int relax_calls;
+static unsigned int relax_again_calls;
+
 /* Set the sizes for all the output sections.  */
 
 static bfd_vma
@@ -5180,14 +5283,24 @@ lang_size_sections_1
 	    asection *i;
 
 	    i = s->input_section.section;
-	    if (relax)
+	    if (relax
+		&& (!relax_only_again
+		    || (s->input_section.relax_again_trip
+			== link_info.relax_trip - 1)))
 	      {
 		bfd_boolean again;
 
 		if (! bfd_relax_section (i->owner, i, &link_info, &again))
 		  einfo (_("%P%F: can't relax section: %E\n"));
+		relax_calls++;
 		if (again)
-		  *relax = TRUE;
+		  {
+		    *relax = TRUE;
+		    s->input_section.relax_again_trip = link_info.relax_trip;
+		    relax_again_calls++;
+		  }
+		else
+		  s->input_section.relax_again_trip = -1;
 	      }
 	    dot = size_input_section (prev, output_section_statement,
 				      fill, dot);
@@ -6480,7 +6593,74 @@ lang_find_relro_sections (void)
     link_info.relro = FALSE;
 }
 
-/* Relax all sections until bfd_relax_section gives up.  */
+/* The addresses and sizes of output sections, and the offsets and
+   sizes of input sections, after a relaxation trip.  */
+
+struct relax_layout
+{
+  bfd_vma *vals;
+  size_t count;
+  size_t alloc;
+};
+
+static void
+relax_layout_add (struct relax_layout *layout, size_t *n, bfd_vma val,
+		  bfd_boolean *changed)
+{
+  if (*n == layout->alloc)
+    {
+      layout->alloc = layout->alloc ? layout->alloc * 2 : 256;
+      layout->vals = (bfd_vma *) xrealloc (layout->vals,
+					   layout->alloc * sizeof (bfd_vma));
+    }
+  if (*n >= layout->count || layout->vals[*n] != val)
+    {
+      layout->vals[*n] = val;
+      *changed = TRUE;
+    }
+  ++*n;
+}
+
+/* Record the current layout in LAYOUT.  Return TRUE if it differs
+   from the layout previously recorded there.  */
+
+static bfd_boolean
+relax_layout_changed (struct relax_layout *layout)
+{
+  bfd_boolean changed = FALSE;
+  size_t n = 0;
+  asection *o, *i;
+
+  if (map_head_is_link_order)
+    return TRUE;
+
+  for (o = link_info.output_bfd->sections; o != NULL; o = o->next)
+    {
+      relax_layout_add (layout, &n, o->vma, &changed);
+      relax_layout_add (layout, &n, o->lma, &changed);
+      relax_layout_add (layout, &n, o->size, &changed);
+      for (i = o->map_head.s; i != NULL; i = i->map_head.s)
+	{
+	  relax_layout_add (layout, &n, i->output_offset, &changed);
+	  relax_layout_add (layout, &n, i->size, &changed);
+	}
+    }
+  if (n != layout->count)
+    changed = TRUE;
+  layout->count = n;
+  return changed;
+}
+
+/* Relax all sections until bfd_relax_section gives up.
+
+   bfd_relax_section is called for every input section on the first
+   trip of each pass, and on any trip following one that moved or
+   resized a section.  If the emulation sets relax_only_again_safe
+   and a trip leaves the layout unchanged, the sections that did not
+   ask to be relaxed again would see exactly what they saw last time,
+   so the next trip only relaxes those that did ask.  Other backends,
+   such as alpha which sizes its GOT and PLT and moves GP on the first
+   call of each trip, have every section relaxed on every trip.  */
 
 void
 lang_relax_sections (bfd_boolean need_layout)
@@ -6489,6 +6669,10 @@ lang_relax_sections (bfd_boolean need_layout)
     {
       /* We may need more than one relaxation pass.  */
       int i = link_info.relax_pass;
+      struct relax_layout layout;
+
+      memset (&layout, 0, sizeof (layout));
+      relax_layout_changed (&layout);
 
       /* The backend can use it to determine the current pass.  */
       link_info.relax_pass = 0;
@@ -6499,8 +6683,12 @@ lang_relax_sections (bfd_boolean need_layout)
 	  bfd_boolean relax_again;
 
 	  link_info.relax_trip = -1;
+	  relax_only_again = FALSE;
 	  do
 	    {
+	      long start_time = get_run_time ();
+	      bfd_boolean layout_changed;
+
 	      link_info.relax_trip++;
 
 	      /* Note: pe-dll.c does something like this also.  If you find
@@ -6518,12 +6706,33 @@ lang_relax_sections (bfd_boolean need_layout)
 	      /* Perform another relax pass - this time we know where the
 		 globals are, so can make a better guess.  */
 	      relax_again = FALSE;
+	      relax_calls = 0;
+	      relax_again_calls = 0;
 	      lang_size_sections (&relax_again, FALSE);
+
+	      layout_changed = relax_layout_changed (&layout);
+	      if (config.stats)
+		{
+		  long run_time = get_run_time () - start_time;
+
+		  fprintf (stderr, _("%s: relax pass %d trip %d: %u sections "
+				     "relaxed, %u again, layout %s, "
+				     "%ld.%06ld\n"),
+			   program_name, link_info.relax_pass,
+			   link_info.relax_trip, relax_calls,
+			   relax_again_calls,
+			   layout_changed ? _("changed") : _("unchanged"),
+			   run_time / 1000000, run_time % 1000000);
+		}
+	      relax_only_again = (link_info.relax_only_again_safe
+				  && !layout_changed);
 	    }
 	  while (relax_again);
+	  relax_only_again = FALSE;
 
 	  link_info.relax_pass++;
 	}
+      free (layout.vals);
       need_layout = TRUE;
     }
 
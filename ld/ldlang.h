@@ -322,6 +322,9 @@ typedef struct
 {
   lang_statement_header_type header;
   asection *section;
+  /* The relaxation trip of the current pass in which the last call
+     to bfd_relax_section asked to see this section again, or -1.  */
+  int relax_again_trip;
 } lang_input_section_type;
 
 struct map_symbol_def {
@@ -355,14 +358,27 @@ typedef void (*walk_wild_section_handler_t) (lang_wild_statement_type *,
 typedef bfd_boolean (*lang_match_sec_type_func) (bfd *, const asection *,
 						 bfd *, const asection *);
 
-/* Binary search tree structure to efficiently sort sections by
-   name.  */
-typedef struct lang_section_bst
+/* A section matched by a sorted wild statement, waiting to be added
+   to the statement's children.  SEQ is the order in which it was
+   matched and keeps the sort stable.  */
+typedef struct lang_sorted_section
 {
   asection *section;
-  struct lang_section_bst *left;
-  struct lang_section_bst *right;
-} lang_section_bst_type;
+  struct flag_info *sflag_info;
+  unsigned int seq;
+} lang_sorted_section_type;
+
+/* Sections collected while walking a sorted wild statement.  They are
+   sorted once the walk is done rather than insertion sorted into the
+   children list one at a time.  */
+typedef struct lang_section_sorter
+{
+  lang_sorted_section_type *sections;
+  unsigned int count;
+  unsigned int alloc;
+  sort_type sort;
+  bfd_boolean filenames_sorted;
+} lang_section_sorter_type;
 
 struct lang_wild_statement_struct
 {
@@ -375,7 +391,7 @@ struct lang_wild_statement_struct
 
   walk_wild_section_handler_t walk_wild_section_handler;
   struct wildcard_list *handler_data[4];
-  lang_section_bst_type *tree;
+  lang_section_sorter_type *sorter;
   struct flag_info *section_flag_list;
 };
 
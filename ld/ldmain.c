@@ -430,6 +430,8 @@ main (int argc, char **argv)
       link_info.output_bfd->flags |= BFD_COMPRESS;
       if (link_info.compress_debug == COMPRESS_DEBUG_GABI_ZLIB)
 	link_info.output_bfd->flags |= BFD_COMPRESS_GABI;
+      else if (link_info.compress_debug == COMPRESS_DEBUG_ZSTD)
+	link_info.output_bfd->flags |= BFD_COMPRESS_GABI | BFD_COMPRESS_ZSTD;
     }
 
   ldwrite ();
@@ -524,6 +526,7 @@ main (int argc, char **argv)
       char *lim = (char *) sbrk (0);
 #endif
       long run_time = get_run_time () - start_time;
+      struct bfd_cache_stats cache_stats;
 
       fflush (stdout);
       fprintf (stderr, _("%s: total time in link: %ld.%06ld\n"),
@@ -532,6 +535,15 @@ main (int argc, char **argv)
       fprintf (stderr, _("%s: data size %ld\n"), program_name,
 	       (long) (lim - start_sbrk));
 #endif
+      bfd_cache_get_stats (&cache_stats);
+      fprintf (stderr, _("%s: file cache: %lu opens, %lu reopens, "
+			 "%lu evictions\n"),
+	       program_name, cache_stats.opens, cache_stats.reopens,
+	       cache_stats.evictions);
+      fprintf (stderr, _("%s: file cache: %lu mapped files, %lu mapped "
+			 "reads, %lu peak mapped bytes\n"),
+	       program_name, cache_stats.views, cache_stats.view_reads,
+	       (unsigned long) cache_stats.view_bytes_peak);
       fflush (stderr);
     }
 